@@ -116,6 +116,26 @@ public:
     return ret;
   } // ... jacobian(...)
 
+  /**
+   * \brief Computes evaluate() and jacobian() (up to rounding) with only one evaluation of each sine and cosine.
+   */
+  void evaluate_with_jacobian(const DomainType& xx,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
+  {
+    const DomainFieldType pre = -0.25 * M_PIl * M_PIl * M_PIl;
+    const DomainFieldType x_arg = M_PI_2l * xx[0];
+    const DomainFieldType y_arg = M_PI_2l * xx[1];
+    const DomainFieldType cos_x = cos(x_arg);
+    const DomainFieldType cos_y = cos(y_arg);
+    const DomainFieldType sin_x = sin(x_arg);
+    const DomainFieldType sin_y = sin(y_arg);
+    value = M_PI_2l * M_PIl * cos_x * cos_y;
+    jacobian[0][0] = pre * sin_x * cos_y;
+    jacobian[0][1] = pre * cos_x * sin_y;
+  } // ... evaluate_with_jacobian(...)
+
 private:
   const int order_;
   const std::string name_;
@@ -202,6 +222,26 @@ public:
     return ret;
   } // ... jacobian(...)
 
+  /**
+   * \brief Computes evaluate() and jacobian() (up to rounding) with only one evaluation of each sine and cosine.
+   */
+  void evaluate_with_jacobian(const DomainType& xx,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
+  {
+    const DomainFieldType pre = -0.5 * M_PIl;
+    const DomainFieldType x_arg = M_PI_2l * xx[0];
+    const DomainFieldType y_arg = M_PI_2l * xx[1];
+    const DomainFieldType cos_x = cos(x_arg);
+    const DomainFieldType cos_y = cos(y_arg);
+    const DomainFieldType sin_x = sin(x_arg);
+    const DomainFieldType sin_y = sin(y_arg);
+    value = cos_x * cos_y;
+    jacobian[0][0] = pre * sin_x * cos_y;
+    jacobian[0][1] = pre * cos_x * sin_y;
+  } // ... evaluate_with_jacobian(...)
+
 private:
   const int order_;
   const std::string name_;
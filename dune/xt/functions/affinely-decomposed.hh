@@ -0,0 +1,493 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_AFFINELY_DECOMPOSED_HH
+#define DUNE_XT_FUNCTIONS_AFFINELY_DECOMPOSED_HH
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <dune/xt/common/memory.hh>
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/xt/functions/exceptions.hh>
+#include <dune/xt/functions/interfaces/function.hh>
+#include <dune/xt/functions/interfaces/grid-function.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+
+
+/**
+ * \brief A function which is affine in its parameter, i.e. a(x; mu) = sum_q theta_q(mu) a_q(x).
+ *
+ *        The components a_q are non-parametric functions, the coefficients theta_q map the parameter to a scalar. This
+ *        allows to treat the components separately (e.g. to assemble them once, see evaluate_components), and to
+ *        evaluate the function for a given parameter at the cost of computing the Q-term sum, see with_parameter:
+\code
+AffinelyDecomposedFunction<d> function({"mu", 1});
+function.add(a_0);
+function.add(a_1, [](const Common::Parameter& mu) { return mu.get("mu")[0]; });
+\endcode
+ *        The decomposition of a ParametricExpressionFunction which is affine in its parameter can be obtained
+ *        automatically, see ParametricExpressionFunction::affine_decomposition.
+ */
+template <size_t d, size_t r = 1, size_t rC = 1, class R = double>
+class AffinelyDecomposedFunction : public FunctionInterface<d, r, rC, R>
+{
+  using BaseType = FunctionInterface<d, r, rC, R>;
+  using ThisType = AffinelyDecomposedFunction<d, r, rC, R>;
+
+public:
+  using typename BaseType::DerivativeRangeReturnType;
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeReturnType;
+  using ComponentType = FunctionInterface<d, r, rC, R>;
+  using CoefficientType = std::function<R(const Common::Parameter&)>;
+
+  /**
+   * \brief This function with precomputed coefficients, see with_parameter.
+   */
+  class ParameterBoundAffinelyDecomposedFunction : public FunctionInterface<d, r, rC, R>
+  {
+    using InterfaceType = FunctionInterface<d, r, rC, R>;
+
+  public:
+    using typename InterfaceType::DerivativeRangeReturnType;
+    using typename InterfaceType::DomainType;
+    using typename InterfaceType::RangeReturnType;
+
+    ParameterBoundAffinelyDecomposedFunction(const ThisType& function, const Common::Parameter& param)
+      : function_(function)
+      , coefficients_(function.coefficients(param))
+    {}
+
+    std::string name() const override final
+    {
+      return function_.name();
+    }
+
+    int order(const Common::Parameter& /*param*/ = {}) const override final
+    {
+      return function_.order();
+    }
+
+    RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                             const Common::Parameter& /*param*/ = {}) const override final
+    {
+      return function_.combine_values(coefficients_, point_in_global_coordinates);
+    }
+
+    DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
+                                       const Common::Parameter& /*param*/ = {}) const override final
+    {
+      return function_.combine_jacobians(coefficients_, point_in_global_coordinates);
+    }
+
+  private:
+    const ThisType& function_;
+    const std::vector<R> coefficients_;
+  }; // class ParameterBoundAffinelyDecomposedFunction
+
+  AffinelyDecomposedFunction(const Common::ParameterType& param_type = {},
+                             const std::string nm = "affinely_decomposed")
+    : BaseType(param_type)
+    , name_(nm)
+  {}
+
+  AffinelyDecomposedFunction(const ThisType& other) = default;
+  AffinelyDecomposedFunction(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  /**
+   * \brief Adds the component coefficient(mu) * component(x), where coefficient is called with the parsed parameter.
+   */
+  ThisType& add(const ComponentType& component, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(component), coefficient);
+  }
+
+  ThisType& add(ComponentType*&& component_ptr, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(std::move(component_ptr)), coefficient);
+  }
+
+  ThisType& add(std::shared_ptr<const ComponentType> component_ptr, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(component_ptr), coefficient);
+  }
+
+  /// \brief Adds a component which does not depend on the parameter.
+  ThisType& add(const ComponentType& component)
+  {
+    return add(component, [](const Common::Parameter& /*param*/) { return R(1); });
+  }
+
+  ThisType& add(ComponentType*&& component_ptr)
+  {
+    return add(std::move(component_ptr), [](const Common::Parameter& /*param*/) { return R(1); });
+  }
+
+  size_t num_components() const
+  {
+    return components_.size();
+  }
+
+  const ComponentType& component(const size_t qq) const
+  {
+    DUNE_THROW_IF(qq >= components_.size(),
+                  Exceptions::wrong_input_given,
+                  "qq = " << qq << "\n   num_components() = " << components_.size());
+    return components_[qq].access();
+  }
+
+  /// \return theta_0(param), ..., theta_{Q - 1}(param), the only part of the function depending on the parameter
+  std::vector<R> coefficients(const Common::Parameter& param = {}) const
+  {
+    const auto parsed_param = this->parse_parameter(param);
+    std::vector<R> ret(coefficients_.size());
+    for (size_t qq = 0; qq < coefficients_.size(); ++qq)
+      ret[qq] = coefficients_[qq](parsed_param);
+    return ret;
+  }
+
+  /**
+   * \brief Evaluates all components, values[qq] = a_qq(x).
+   * \attention values will be resized!
+   */
+  void evaluate_components(const DomainType& point_in_global_coordinates, std::vector<RangeReturnType>& values) const
+  {
+    values.resize(components_.size());
+    for (size_t qq = 0; qq < components_.size(); ++qq)
+      values[qq] = components_[qq].access().evaluate(point_in_global_coordinates);
+  }
+
+  /**
+   * \brief Computes the jacobians of all components, jacobians[qq] = Da_qq(x).
+   * \attention jacobians will be resized!
+   */
+  void jacobians_of_components(const DomainType& point_in_global_coordinates,
+                               std::vector<DerivativeRangeReturnType>& jacobians) const
+  {
+    jacobians.resize(components_.size());
+    for (size_t qq = 0; qq < components_.size(); ++qq)
+      jacobians[qq] = components_[qq].access().jacobian(point_in_global_coordinates);
+  }
+
+  std::string name() const override final
+  {
+    return name_;
+  }
+
+  int order(const Common::Parameter& /*param*/ = {}) const override final
+  {
+    int ret = 0;
+    for (const auto& component : components_)
+      ret = std::max(ret, component.access().order());
+    return ret;
+  }
+
+  /**
+   * \note For many evaluations with the same parameter, use with_parameter instead, which computes the coefficients
+   *       only once.
+   */
+  RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                           const Common::Parameter& param = {}) const override final
+  {
+    return combine_values(coefficients(param), point_in_global_coordinates);
+  }
+
+  DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
+                                     const Common::Parameter& param = {}) const override final
+  {
+    return combine_jacobians(coefficients(param), point_in_global_coordinates);
+  }
+
+  std::unique_ptr<BaseType> with_parameter(const Common::Parameter& param) const override final
+  {
+    return std::make_unique<ParameterBoundAffinelyDecomposedFunction>(*this, param);
+  }
+
+private:
+  ThisType& add_component(Common::ConstStorageProvider<ComponentType>&& component, const CoefficientType& coefficient)
+  {
+    DUNE_THROW_IF(component.access().is_parametric(),
+                  Exceptions::wrong_input_given,
+                  "The components of an affinely decomposed function must not be parametric!\n   "
+                      << "component.parameter_type() = " << component.access().parameter_type());
+    components_.emplace_back(std::move(component));
+    coefficients_.emplace_back(coefficient);
+    return *this;
+  }
+
+  RangeReturnType combine_values(const std::vector<R>& coeffs, const DomainType& point_in_global_coordinates) const
+  {
+    RangeReturnType ret;
+    for (size_t qq = 0; qq < components_.size(); ++qq) {
+      auto value = components_[qq].access().evaluate(point_in_global_coordinates);
+      value *= coeffs[qq];
+      ret += value;
+    }
+    return ret;
+  }
+
+  DerivativeRangeReturnType combine_jacobians(const std::vector<R>& coeffs,
+                                              const DomainType& point_in_global_coordinates) const
+  {
+    DerivativeRangeReturnType ret;
+    for (size_t qq = 0; qq < components_.size(); ++qq) {
+      auto jacobian = components_[qq].access().jacobian(point_in_global_coordinates);
+      jacobian *= coeffs[qq];
+      ret += jacobian;
+    }
+    return ret;
+  }
+
+  std::string name_;
+  std::vector<Common::ConstStorageProvider<ComponentType>> components_;
+  std::vector<CoefficientType> coefficients_;
+}; // class AffinelyDecomposedFunction
+
+
+/**
+ * \brief A grid function which is affine in its parameter, i.e. a(x; mu) = sum_q theta_q(mu) a_q(x), see
+ *        AffinelyDecomposedFunction.
+ *
+ *        Its local functions bind the local functions of all components at once, which are available to assemblers via
+ *        LocalAffinelyDecomposedFunction::evaluate_components (see static_local_function). The coefficients are
+ *        computed once per bind_parameter, so that evaluations with the bound parameter only amount to the Q-term sum.
+ */
+template <class E, size_t r = 1, size_t rC = 1, class R = double>
+class AffinelyDecomposedGridFunction
+  : public StaticGridFunctionInterface<AffinelyDecomposedGridFunction<E, r, rC, R>, E, r, rC, R>
+{
+  using BaseType = StaticGridFunctionInterface<AffinelyDecomposedGridFunction<E, r, rC, R>, E, r, rC, R>;
+  using ThisType = AffinelyDecomposedGridFunction<E, r, rC, R>;
+
+public:
+  using typename BaseType::ElementType;
+  using typename BaseType::LocalFunctionType;
+  using ComponentType = GridFunctionInterface<E, r, rC, R>;
+  using CoefficientType = std::function<R(const Common::Parameter&)>;
+
+private:
+  class LocalAffinelyDecomposedFunction final : public ElementFunctionInterface<E, r, rC, R>
+  {
+    using InterfaceType = ElementFunctionInterface<E, r, rC, R>;
+
+  public:
+    using typename InterfaceType::DerivativeRangeReturnType;
+    using typename InterfaceType::DomainType;
+    using typename InterfaceType::ElementType;
+    using typename InterfaceType::RangeReturnType;
+
+    LocalAffinelyDecomposedFunction(const ThisType& grid_function)
+      : InterfaceType(grid_function.parameter_type())
+      , grid_function_(grid_function)
+      , coefficients_bound_(false)
+    {
+      for (const auto& component : grid_function_.components_)
+        local_components_.emplace_back(component.access().local_function());
+    }
+
+  protected:
+    void post_bind(const ElementType& element) override final
+    {
+      for (auto& local_component : local_components_)
+        local_component->bind(element);
+    }
+
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      bound_coefficients_ = grid_function_.coefficients(param);
+      coefficients_bound_ = true;
+    }
+
+  public:
+    int order(const Common::Parameter& /*param*/ = {}) const override final
+    {
+      int ret = 0;
+      for (const auto& local_component : local_components_)
+        ret = std::max(ret, local_component->order());
+      return ret;
+    }
+
+    using InterfaceType::evaluate;
+
+    RangeReturnType evaluate(const DomainType& point_in_reference_element,
+                             const Common::Parameter& param = {}) const override final
+    {
+      const auto& coeffs = coefficients(param);
+      RangeReturnType ret;
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        auto value = local_components_[qq]->evaluate(point_in_reference_element);
+        value *= coeffs[qq];
+        ret += value;
+      }
+      return ret;
+    }
+
+    using InterfaceType::jacobian;
+
+    DerivativeRangeReturnType jacobian(const DomainType& point_in_reference_element,
+                                       const Common::Parameter& param = {}) const override final
+    {
+      const auto& coeffs = coefficients(param);
+      DerivativeRangeReturnType ret;
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        auto jacobian = local_components_[qq]->jacobian(point_in_reference_element);
+        jacobian *= coeffs[qq];
+        ret += jacobian;
+      }
+      return ret;
+    }
+
+    size_t num_components() const
+    {
+      return local_components_.size();
+    }
+
+    const LocalFunctionType& local_component(const size_t qq) const
+    {
+      assert(qq < local_components_.size());
+      return *local_components_[qq];
+    }
+
+    /**
+     * \brief Evaluates the local functions of all components, values[qq] = a_qq(x).
+     * \attention values will be resized!
+     */
+    void evaluate_components(const DomainType& point_in_reference_element, std::vector<RangeReturnType>& values) const
+    {
+      values.resize(local_components_.size());
+      for (size_t qq = 0; qq < local_components_.size(); ++qq)
+        values[qq] = local_components_[qq]->evaluate(point_in_reference_element);
+    }
+
+  private:
+    /// the bound coefficients (see bind_parameter), if param is empty
+    const std::vector<R>& coefficients(const Common::Parameter& param) const
+    {
+      if (coefficients_bound_ && param.empty())
+        return bound_coefficients_;
+      coefficients_ = grid_function_.coefficients(param);
+      return coefficients_;
+    }
+
+    const ThisType& grid_function_;
+    std::vector<std::unique_ptr<LocalFunctionType>> local_components_;
+    std::vector<R> bound_coefficients_;
+    bool coefficients_bound_;
+    mutable std::vector<R> coefficients_;
+  }; // class LocalAffinelyDecomposedFunction
+
+public:
+  using StaticLocalFunctionType = LocalAffinelyDecomposedFunction;
+
+  AffinelyDecomposedGridFunction(const Common::ParameterType& param_type = {},
+                                 const std::string nm = "affinely_decomposed")
+    : BaseType(param_type)
+    , name_(nm)
+  {}
+
+  AffinelyDecomposedGridFunction(const ThisType& other) = default;
+  AffinelyDecomposedGridFunction(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  /**
+   * \brief Adds the component coefficient(mu) * component(x), where coefficient is called with the parsed parameter.
+   */
+  ThisType& add(const ComponentType& component, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(component), coefficient);
+  }
+
+  ThisType& add(ComponentType*&& component_ptr, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(std::move(component_ptr)), coefficient);
+  }
+
+  ThisType& add(std::shared_ptr<const ComponentType> component_ptr, const CoefficientType& coefficient)
+  {
+    return add_component(Common::ConstStorageProvider<ComponentType>(component_ptr), coefficient);
+  }
+
+  /// \brief Adds a component which does not depend on the parameter.
+  ThisType& add(const ComponentType& component)
+  {
+    return add(component, [](const Common::Parameter& /*param*/) { return R(1); });
+  }
+
+  ThisType& add(ComponentType*&& component_ptr)
+  {
+    return add(std::move(component_ptr), [](const Common::Parameter& /*param*/) { return R(1); });
+  }
+
+  size_t num_components() const
+  {
+    return components_.size();
+  }
+
+  const ComponentType& component(const size_t qq) const
+  {
+    DUNE_THROW_IF(qq >= components_.size(),
+                  Exceptions::wrong_input_given,
+                  "qq = " << qq << "\n   num_components() = " << components_.size());
+    return components_[qq].access();
+  }
+
+  /// \return theta_0(param), ..., theta_{Q - 1}(param), the only part of the function depending on the parameter
+  std::vector<R> coefficients(const Common::Parameter& param = {}) const
+  {
+    const auto parsed_param = this->parse_parameter(param);
+    std::vector<R> ret(coefficients_.size());
+    for (size_t qq = 0; qq < coefficients_.size(); ++qq)
+      ret[qq] = coefficients_[qq](parsed_param);
+    return ret;
+  }
+
+  std::string name() const override final
+  {
+    return name_;
+  }
+
+  std::unique_ptr<StaticLocalFunctionType> static_local_function() const
+  {
+    return std::make_unique<LocalAffinelyDecomposedFunction>(*this);
+  }
+
+private:
+  ThisType& add_component(Common::ConstStorageProvider<ComponentType>&& component, const CoefficientType& coefficient)
+  {
+    DUNE_THROW_IF(component.access().is_parametric(),
+                  Exceptions::wrong_input_given,
+                  "The components of an affinely decomposed grid function must not be parametric!\n   "
+                      << "component.parameter_type() = " << component.access().parameter_type());
+    components_.emplace_back(std::move(component));
+    coefficients_.emplace_back(coefficient);
+    return *this;
+  }
+
+  std::string name_;
+  std::vector<Common::ConstStorageProvider<ComponentType>> components_;
+  std::vector<CoefficientType> coefficients_;
+}; // class AffinelyDecomposedGridFunction
+
+
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_AFFINELY_DECOMPOSED_HH
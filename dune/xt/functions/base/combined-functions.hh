@@ -92,6 +92,7 @@ public:
   using RangeReturnType = typename RightType::RangeReturnType;
   using ScalarRangeReturnType = typename LeftType::RangeReturnType;
   using DerivativeRangeReturnType = typename FunctionInterface<d, r, rC, R>::DerivativeRangeReturnType;
+  using ScalarDerivativeRangeReturnType = typename LeftType::DerivativeRangeReturnType;
 
 private:
   template <CombinationType cc, bool anything = true>
@@ -129,6 +130,21 @@ private:
     {
       return left_.jacobian(point_in_global_coordinates, param) - right_.jacobian(point_in_global_coordinates, param);
     } // ... jacobian(...)
+
+    static void evaluate_with_jacobian(const LeftType& left_,
+                                       const RightType& right_,
+                                       const DomainType& point_in_global_coordinates,
+                                       RangeReturnType& value,
+                                       DerivativeRangeReturnType& jacobian,
+                                       const Common::Parameter& param)
+    {
+      RangeReturnType right_value;
+      DerivativeRangeReturnType right_jacobian;
+      left_.evaluate_with_jacobian(point_in_global_coordinates, value, jacobian, param);
+      right_.evaluate_with_jacobian(point_in_global_coordinates, right_value, right_jacobian, param);
+      value -= right_value;
+      jacobian -= right_jacobian;
+    } // ... evaluate_with_jacobian(...)
   }; // class Call< ..., difference >
 
   template <bool anything>
@@ -160,6 +176,21 @@ private:
     {
       return left_.jacobian(point_in_global_coordinates, param) + right_.jacobian(point_in_global_coordinates, param);
     } // ... jacobian(...)
+
+    static void evaluate_with_jacobian(const LeftType& left_,
+                                       const RightType& right_,
+                                       const DomainType& point_in_global_coordinates,
+                                       RangeReturnType& value,
+                                       DerivativeRangeReturnType& jacobian,
+                                       const Common::Parameter& param)
+    {
+      RangeReturnType right_value;
+      DerivativeRangeReturnType right_jacobian;
+      left_.evaluate_with_jacobian(point_in_global_coordinates, value, jacobian, param);
+      right_.evaluate_with_jacobian(point_in_global_coordinates, right_value, right_jacobian, param);
+      value += right_value;
+      jacobian += right_jacobian;
+    } // ... evaluate_with_jacobian(...)
   }; // class Call< ..., sum >
 
   // left only scalar atm
@@ -190,14 +221,66 @@ private:
       return right_eval;
     } // ... evaluate(...)
 
-    static DerivativeRangeReturnType jacobian(const LeftType& /*left_*/,
-                                              const RightType& /*right_*/,
-                                              const DomainType& /*point_in_global_coordinates*/,
-                                              const Common::Parameter& /*param*/)
+    static DerivativeRangeReturnType jacobian(const LeftType& left_,
+                                              const RightType& right_,
+                                              const DomainType& point_in_global_coordinates,
+                                              const Common::Parameter& param)
     {
-      DUNE_THROW(NotImplemented, "If you need this, implement it!");
-      return DerivativeRangeReturnType();
+      RangeReturnType value;
+      DerivativeRangeReturnType ret;
+      evaluate_with_jacobian(left_, right_, point_in_global_coordinates, value, ret, param);
+      return ret;
     }
+
+    /// (l * f)' = l' * f + l * f'
+    static void evaluate_with_jacobian(const LeftType& left_,
+                                       const RightType& right_,
+                                       const DomainType& point_in_global_coordinates,
+                                       RangeReturnType& value,
+                                       DerivativeRangeReturnType& jacobian,
+                                       const Common::Parameter& param)
+    {
+      ScalarRangeReturnType left_value;
+      ScalarDerivativeRangeReturnType left_jacobian;
+      left_.evaluate_with_jacobian(point_in_global_coordinates, left_value, left_jacobian, param);
+      right_.evaluate_with_jacobian(point_in_global_coordinates, value, jacobian, param);
+      if (left_value.size() != 1)
+        DUNE_THROW(NotImplemented, "Only available for scalar left type!");
+      product_rule<>::apply(left_value[0], left_jacobian[0], value, jacobian);
+      value *= left_value[0];
+    } // ... evaluate_with_jacobian(...)
+
+  private:
+    template <size_t rC_ = rC, bool anything_ = true>
+    struct product_rule
+    {
+      template <class L>
+      static void apply(const R& left_value,
+                        const L& left_gradient,
+                        const RangeReturnType& right_value,
+                        DerivativeRangeReturnType& jacobian)
+      {
+        for (size_t ii = 0; ii < r; ++ii)
+          for (size_t jj = 0; jj < rC; ++jj)
+            for (size_t dd = 0; dd < d; ++dd)
+              jacobian[ii][jj][dd] = left_value * jacobian[ii][jj][dd] + left_gradient[dd] * right_value[ii][jj];
+      }
+    }; // struct product_rule<...>
+
+    template <bool anything_>
+    struct product_rule<1, anything_>
+    {
+      template <class L>
+      static void apply(const R& left_value,
+                        const L& left_gradient,
+                        const RangeReturnType& right_value,
+                        DerivativeRangeReturnType& jacobian)
+      {
+        for (size_t ii = 0; ii < r; ++ii)
+          for (size_t dd = 0; dd < d; ++dd)
+            jacobian[ii][dd] = left_value * jacobian[ii][dd] + left_gradient[dd] * right_value[ii];
+      }
+    }; // struct product_rule<..., 1>
   }; // class Call< ..., product >
 
 public:
@@ -226,6 +309,16 @@ public:
   {
     return Call<comb>::jacobian(left_, right_, point_in_global_coordinates, param);
   }
+
+  static void evaluate_with_jacobian(const LeftType& left_,
+                                     const RightType& right_,
+                                     const DomainType& point_in_global_coordinates,
+                                     RangeReturnType& value,
+                                     DerivativeRangeReturnType& jacobian,
+                                     const Common::Parameter& param)
+  {
+    Call<comb>::evaluate_with_jacobian(left_, right_, point_in_global_coordinates, value, jacobian, param);
+  }
 }; // class SelectCombined
 
 
@@ -371,6 +464,15 @@ public:
     return Select::jacobian(left_->access(), right_->access(), point_in_global_coordinates, param);
   }
 
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& param = {}) const override final
+  {
+    Select::evaluate_with_jacobian(
+        left_->access(), right_->access(), point_in_global_coordinates, value, jacobian, param);
+  }
+
 private:
   static std::string get_name(const LeftType& left, const RightType& right, const std::string& nm)
   {
@@ -277,6 +277,12 @@ protected:
     right_local_->bind(element);
   }
 
+  void post_bind_parameter(const Common::Parameter& param) override final
+  {
+    left_local_->bind_parameter(param);
+    right_local_->bind_parameter(param);
+  }
+
 public:
   int order(const XT::Common::Parameter& param = {}) const override final
   {
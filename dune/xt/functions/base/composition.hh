@@ -13,6 +13,10 @@
 #ifndef DUNE_XT_FUNCTIONS_COMPOSITION_HH
 #define DUNE_XT_FUNCTIONS_COMPOSITION_HH
 
+#include <memory>
+#include <vector>
+
+#include <dune/geometry/referenceelements.hh>
 #include <dune/grid/yaspgrid.hh>
 
 #include <dune/xt/common/configuration.hh>
@@ -37,27 +41,48 @@ struct GeneralElementFunctionChooser
   using ElementType = typename GridFunctionInterfaceType::ElementType;
   using DomainFieldType = typename GridFunctionInterfaceType::DomainFieldType;
   using RangeFieldType = typename GridFunctionInterfaceType::RangeFieldType;
-  using DomainType = typename GridFunctionInterfaceType::DomainType;
-  using RangeType = typename GridFunctionInterfaceType::RangeType;
-  using DerivativeRangeType = typename GridFunctionInterfaceType::DerivativeRangeType;
   static const size_t domain_dim = GridFunctionInterfaceType::domain_dim;
   static const size_t range_dim = GridFunctionInterfaceType::range_dim;
   static const size_t range_dim_cols = GridFunctionInterfaceType::range_dim_cols;
 
+  /**
+   * \brief Evaluates the outer function at the values of the inner function.
+   *
+   *        The outer element found last is kept as a hint: values of the inner function contained in it require neither
+   *        a search nor a rebind of the outer local function. Use evaluate_at_points() to evaluate at several points
+   *        at once (e.g., all quadrature points of an element), which locates all values not contained in the hint with
+   *        a single search. The batched evaluate_at_points of ElementFunctionSetInterface (used, e.g., by
+   *        ElementFunctionSetTabulation) does the same for all points of a quadrature.
+   */
   class ElementFunction : public ElementFunctionInterface<ElementType, range_dim, range_dim_cols, RangeFieldType>
   {
     using BaseType = ElementFunctionInterface<ElementType, range_dim, range_dim_cols, RangeFieldType>;
+    using OuterElementType = typename OuterType::ElementType;
+    using OuterDomainType = typename OuterType::LocalFunctionType::DomainType;
+    using OuterElementSearchType = typename Grid::EntityInlevelSearch<OuterGridViewType>;
 
   public:
+    using BaseType::d;
+    using BaseType::r;
+    using BaseType::rC;
+    using typename BaseType::D;
+    using typename BaseType::DerivativeRangeReturnType;
+    using typename BaseType::DomainType;
+    using typename BaseType::R;
+    using typename BaseType::RangeReturnType;
+
     ElementFunction(const InnerType& inner_function,
                     const OuterType& outer_function,
-                    std::shared_ptr<typename Grid::EntityInlevelSearch<OuterGridViewType>>& element_search)
+                    std::shared_ptr<OuterElementSearchType>& element_search)
       : BaseType()
       , inner_function_(inner_function)
       , outer_function_(outer_function)
       , element_search_(element_search)
       , local_inner_function_(inner_function_.local_function())
       , local_outer_function_(outer_function_.local_function())
+      , outer_element_(nullptr)
+      , hint_(nullptr)
+      , single_point_(1)
     {}
 
     ElementFunction(const ElementFunction& /*other*/) = delete;
@@ -65,45 +90,160 @@ struct GeneralElementFunctionChooser
     ElementFunction& operator=(const ElementFunction& /*other*/) = delete;
 
   protected:
-    void post_bind(const ElementType& element)
+    void post_bind(const ElementType& element) override final
     {
+      // the outer element is kept, neighboring elements are likely to be mapped to it as well
       local_inner_function_->bind(element);
     }
 
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      local_inner_function_->bind_parameter(param);
+      local_outer_function_->bind_parameter(param);
+    }
+
   public:
     int order(const XT::Common::Parameter& /*param*/ = {}) const override final
     {
       return 2;
     }
 
-    RangeType evaluate(const DomainType& xx) const override final
+    RangeReturnType evaluate(const DomainType& point_in_reference_element,
+                             const Common::Parameter& param = {}) const override final
     {
       // evaluate inner function
-      const auto inner_value = local_inner_function_->evaluate(xx);
-      // find element on outer grid the value of inner function belongs to
-      const auto element_ptrs = (*element_search_)(std::vector<typename OuterType::DomainType>(1, inner_value));
-      const auto& element_ptr = element_ptrs[0];
-      if (element_ptr == nullptr)
-        DUNE_THROW(Dune::InvalidStateException,
-                   "Could not find element, maybe inner function does not map to the domain of outer function");
-      const auto& outer_element = *element_ptr;
+      single_point_[0] = local_inner_function_->evaluate(point_in_reference_element, param);
+      const auto& inner_value = single_point_[0];
+      // find element on outer grid the value of inner function belongs to, if it is not the last one
+      if (!outer_element_contains(inner_value))
+        bind_outer(find_outer_elements(single_point_)[0]);
       // evaluate outer function
-      local_outer_function_->bind(outer_element);
-      return local_outer_function_->evaluate(outer_element.geometry().local(inner_value));
-    }
-
-    DerivativeRangeType jacobian(const DomainType& /*xx*/) const override final
+      return local_outer_function_->evaluate(outer_element_->geometry().local(inner_value), param);
+    } // ... evaluate(...)
+
+    /**
+     * \brief Evaluates at all points_in_reference_element, s.t. result[ii] = evaluate(points_in_reference_element[ii]).
+     *
+     * \note result is only resized if it is too small.
+     */
+    void evaluate_at_points(const std::vector<DomainType>& points_in_reference_element,
+                            std::vector<RangeReturnType>& result,
+                            const Common::Parameter& param = {}) const
+    {
+      const size_t num_points = points_in_reference_element.size();
+      if (result.size() < num_points)
+        result.resize(num_points);
+      // evaluate inner function, and collect the values not contained in the last outer element
+      inner_values_.resize(num_points);
+      missed_points_.clear();
+      missed_inner_values_.clear();
+      for (size_t ii = 0; ii < num_points; ++ii) {
+        inner_values_[ii] = local_inner_function_->evaluate(points_in_reference_element[ii], param);
+        if (!outer_element_contains(inner_values_[ii])) {
+          missed_points_.push_back(ii);
+          missed_inner_values_.push_back(inner_values_[ii]);
+        }
+      }
+      if (outer_element_)
+        assign(hint_, *outer_element_);
+      // find elements on outer grid for these with a single search
+      std::vector<std::unique_ptr<OuterElementType>> missed_element_ptrs;
+      if (!missed_points_.empty())
+        missed_element_ptrs = find_outer_elements(missed_inner_values_);
+      // evaluate outer function, rebinding only if the element changes
+      size_t kk = 0;
+      for (size_t ii = 0; ii < num_points; ++ii) {
+        if (kk < missed_points_.size() && missed_points_[kk] == ii)
+          bind_outer(missed_element_ptrs[kk++]);
+        else if (*outer_element_ != *hint_)
+          bind_outer(*hint_);
+        result[ii] = local_outer_function_->evaluate(outer_element_->geometry().local(inner_values_[ii]), param);
+      }
+    } // ... evaluate_at_points(...)
+
+    /**
+     * \brief Evaluates at all points of quadrature with a single search, see evaluate_at_points() above and
+     *        ElementFunctionSetInterface::evaluate_at_points.
+     */
+    void evaluate_at_points(const QuadratureRule<D, d>& quadrature,
+                            R* result,
+                            const SetEvaluationLayout layout = SetEvaluationLayout::point_function_component,
+                            const Common::Parameter& param = {}) const override final
+    {
+      const size_t num_points = quadrature.size();
+      quadrature_points_.resize(num_points);
+      for (size_t pp = 0; pp < num_points; ++pp)
+        quadrature_points_[pp] = quadrature[pp].position();
+      this->evaluate_at_points(quadrature_points_, quadrature_values_, param);
+      for (size_t pp = 0; pp < num_points; ++pp) {
+        R* dst = result + set_evaluation_index(layout, num_points, 1, pp, 0) * r * rC;
+        internal::write_entries(quadrature_values_[pp], dst);
+      }
+    } // ... evaluate_at_points(...)
+
+    DerivativeRangeReturnType jacobian(const DomainType& /*point_in_reference_element*/,
+                                       const Common::Parameter& /*param*/ = {}) const override final
     {
       DUNE_THROW(Dune::NotImplemented, "");
     }
 
   private:
+    bool outer_element_contains(const OuterDomainType& point) const
+    {
+      if (!outer_element_)
+        return false;
+      return ReferenceElements<typename OuterType::DomainFieldType, OuterType::domain_dim>::general(
+                 outer_element_->type())
+          .checkInside(outer_element_->geometry().local(point));
+    }
+
+    std::vector<std::unique_ptr<OuterElementType>> find_outer_elements(const std::vector<OuterDomainType>& points) const
+    {
+      auto element_ptrs = (*element_search_)(points);
+      DUNE_THROW_IF(element_ptrs.size() != points.size(),
+                    Dune::InvalidStateException,
+                    "element_ptrs.size() = " << element_ptrs.size() << "\n   points.size() = " << points.size());
+      for (const auto& element_ptr : element_ptrs)
+        DUNE_THROW_IF(element_ptr == nullptr,
+                      Dune::InvalidStateException,
+                      "Could not find element, maybe inner function does not map to the domain of outer function");
+      return element_ptrs;
+    } // ... find_outer_elements(...)
+
+    void bind_outer(const std::unique_ptr<OuterElementType>& element_ptr) const
+    {
+      bind_outer(*element_ptr);
+    }
+
+    void bind_outer(const OuterElementType& outer_element) const
+    {
+      if (outer_element_ && *outer_element_ == outer_element)
+        return;
+      assign(outer_element_, outer_element);
+      local_outer_function_->bind(*outer_element_);
+    }
+
+    static void assign(std::unique_ptr<OuterElementType>& ptr, const OuterElementType& outer_element)
+    {
+      if (ptr)
+        *ptr = outer_element;
+      else
+        ptr = std::make_unique<OuterElementType>(outer_element);
+    }
+
     const InnerType& inner_function_;
     const OuterType& outer_function_;
-    std::shared_ptr<typename Grid::EntityInlevelSearch<OuterGridViewType>>& element_search_;
-    std::unique_ptr<typename InnerType::LocalFunctionType>& local_inner_function_;
-    std::unique_ptr<typename OuterType::LocalFunctionType>& local_outer_function_;
-    const ElementType& element_;
+    std::shared_ptr<OuterElementSearchType>& element_search_;
+    std::unique_ptr<typename InnerType::LocalFunctionType> local_inner_function_;
+    mutable std::unique_ptr<typename OuterType::LocalFunctionType> local_outer_function_;
+    mutable std::unique_ptr<OuterElementType> outer_element_;
+    mutable std::unique_ptr<OuterElementType> hint_;
+    mutable std::vector<OuterDomainType> single_point_;
+    mutable std::vector<OuterDomainType> inner_values_;
+    mutable std::vector<size_t> missed_points_;
+    mutable std::vector<OuterDomainType> missed_inner_values_;
+    mutable std::vector<DomainType> quadrature_points_;
+    mutable std::vector<RangeReturnType> quadrature_values_;
   }; // class ElementFunction
 }; // GeneralElementFunctionChooser
 
@@ -118,9 +258,6 @@ struct ElementFunctionForGlobalChooser
   using ElementType = typename GridFunctionInterfaceType::ElementType;
   using DomainFieldType = typename GridFunctionInterfaceType::DomainFieldType;
   using RangeFieldType = typename GridFunctionInterfaceType::RangeFieldType;
-  using DomainType = typename InnerType::DomainType;
-  using RangeType = typename OuterType::RangeType;
-  using DerivativeRangeType = typename OuterType::DerivativeRangeType;
   static const size_t domain_dim = GridFunctionInterfaceType::domain_dim;
   static const size_t range_dim = GridFunctionInterfaceType::range_dim;
   static const size_t range_dim_cols = GridFunctionInterfaceType::range_dim_cols;
@@ -128,40 +265,89 @@ struct ElementFunctionForGlobalChooser
   class ElementFunction : public ElementFunctionInterface<ElementType, range_dim, range_dim_cols, RangeFieldType>
   {
     using BaseType = ElementFunctionInterface<ElementType, range_dim, range_dim_cols, RangeFieldType>;
+    using GlobalFunctionInterfaceType = FunctionInterface<OuterType::domain_dim,
+                                                          OuterType::range_dim,
+                                                          OuterType::range_dim_cols,
+                                                          typename OuterType::RangeFieldType>;
 
   public:
+    using BaseType::d;
+    using BaseType::r;
+    using BaseType::rC;
+    using typename BaseType::D;
+    using typename BaseType::DerivativeRangeReturnType;
+    using typename BaseType::DomainType;
+    using typename BaseType::R;
+    using typename BaseType::RangeReturnType;
+
     ElementFunction(const InnerType& localizable_function,
                     const OuterType& global_function,
                     std::shared_ptr<typename Grid::EntityInlevelSearch<OuterGridViewType>>& /*element_search*/)
       : BaseType()
       , localizable_function_(localizable_function)
       , global_function_(global_function)
+      , local_function_(localizable_function_.local_function())
     {}
 
     ElementFunction(const ElementFunction& /*other*/) = delete;
 
     ElementFunction& operator=(const ElementFunction& /*other*/) = delete;
 
+  protected:
+    void post_bind(const ElementType& element) override final
+    {
+      local_function_->bind(element);
+    }
+
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      local_function_->bind_parameter(param);
+      bound_global_function_ = global_function_.with_parameter(param);
+    }
+
+  public:
     int order(const XT::Common::Parameter& param = {}) const override final
     {
-      return global_function_.order(param) * localizable_function_.local_function(element_)->order(param);
+      return global_function(param).order(param) * local_function_->order(param);
     }
 
-    RangeType evaluate(const DomainType& xx, const XT::Common::Parameter& param = {}) const override final
+    RangeReturnType evaluate(const DomainType& point_in_reference_element,
+                             const XT::Common::Parameter& param = {}) const override final
     {
-      return global_function_.evaluate(localizable_function_.local_function(element_)->evaluate(xx, param), param);
+      return global_function(param).evaluate(local_function_->evaluate(point_in_reference_element, param), param);
     }
 
-    DerivativeRangeType jacobian(const DomainType& /*xx*/,
-                                 const XT::Common::Parameter& /*param*/ = {}) const override final
+    void evaluate_at_points(const QuadratureRule<D, d>& quadrature,
+                            R* result,
+                            const SetEvaluationLayout layout = SetEvaluationLayout::point_function_component,
+                            const Common::Parameter& param = {}) const override final
+    {
+      const size_t num_points = quadrature.size();
+      for (size_t pp = 0; pp < num_points; ++pp) {
+        R* dst = result + set_evaluation_index(layout, num_points, 1, pp, 0) * r * rC;
+        internal::write_entries(this->evaluate(quadrature[pp].position(), param), dst);
+      }
+    } // ... evaluate_at_points(...)
+
+    DerivativeRangeReturnType jacobian(const DomainType& /*point_in_reference_element*/,
+                                       const XT::Common::Parameter& /*param*/ = {}) const override final
     {
       DUNE_THROW(Dune::NotImplemented, "");
     }
 
   private:
+    /// the global function with the bound parameter (see bind_parameter), if param is empty
+    const GlobalFunctionInterfaceType& global_function(const Common::Parameter& param) const
+    {
+      if (bound_global_function_ && param.empty())
+        return *bound_global_function_;
+      return global_function_;
+    }
+
     const InnerType& localizable_function_;
     const OuterType& global_function_;
-    const ElementType& element_;
+    std::unique_ptr<typename InnerType::LocalFunctionType> local_function_;
+    std::unique_ptr<const GlobalFunctionInterfaceType> bound_global_function_;
   }; // class ElementFunction
 }; // ElementFunctionForGlobalChooser
 
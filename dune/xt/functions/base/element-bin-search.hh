@@ -0,0 +1,196 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_ELEMENT_BIN_SEARCH_HH
+#define DUNE_XT_FUNCTIONS_BASE_ELEMENT_BIN_SEARCH_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace internal {
+
+
+/**
+ * \brief Finds the element of a grid layer containing a given point, using a uniform grid of bins over the bounding box
+ *        of the grid layer.
+ *
+ *        Each bin holds the elements whose bounding box intersects it, so a search amounts to checking the few
+ *        elements of one bin (as opposed to a hierarchical search from the macro elements, as in
+ *        XT::Grid::EntityInlevelSearch). The number of bins is roughly the number of elements. The elements are copied,
+ *        so the search has to be rebuilt if the grid changes.
+ */
+template <class GridLayerType>
+class ElementBinSearch
+{
+  static_assert(XT::Grid::is_layer<GridLayerType>::value, "");
+
+public:
+  using ElementType = XT::Grid::extract_entity_t<GridLayerType>;
+  using D = typename ElementType::Geometry::ctype;
+  static const constexpr size_t d = ElementType::dimension;
+  using DomainType = FieldVector<D, d>;
+
+  /// returned by find() if no element contains the point
+  static const constexpr size_t not_found = std::numeric_limits<size_t>::max();
+
+  explicit ElementBinSearch(const GridLayerType& grid_layer)
+    : lower_left_(std::numeric_limits<D>::max())
+    , upper_right_(std::numeric_limits<D>::lowest())
+    , num_bins_(1)
+    , bin_width_(1)
+  {
+    // collect the elements and their bounding boxes
+    std::vector<DomainType> element_lower_lefts;
+    std::vector<DomainType> element_upper_rights;
+    for (auto&& element : elements(grid_layer)) {
+      const auto geometry = element.geometry();
+      DomainType ll = geometry.corner(0);
+      DomainType ur = ll;
+      for (int cc = 1; cc < geometry.corners(); ++cc) {
+        const auto corner = geometry.corner(cc);
+        for (size_t dd = 0; dd < d; ++dd) {
+          ll[dd] = std::min(ll[dd], corner[dd]);
+          ur[dd] = std::max(ur[dd], corner[dd]);
+        }
+      }
+      for (size_t dd = 0; dd < d; ++dd) {
+        lower_left_[dd] = std::min(lower_left_[dd], ll[dd]);
+        upper_right_[dd] = std::max(upper_right_[dd], ur[dd]);
+      }
+      elements_.emplace_back(element);
+      element_lower_lefts.emplace_back(ll);
+      element_upper_rights.emplace_back(ur);
+    }
+    if (elements_.empty())
+      return;
+    // choose roughly as many bins as elements, and enlarge the bounding box slightly to cope with rounding
+    const size_t bins_per_dim = std::max(
+        size_t(1), static_cast<size_t>(std::round(std::pow(static_cast<double>(elements_.size()), 1. / d))));
+    for (size_t dd = 0; dd < d; ++dd) {
+      const D tolerance = 1e-10 * std::max(D(1), upper_right_[dd] - lower_left_[dd]);
+      lower_left_[dd] -= tolerance;
+      upper_right_[dd] += tolerance;
+      num_bins_[dd] = bins_per_dim;
+      bin_width_[dd] = (upper_right_[dd] - lower_left_[dd]) / bins_per_dim;
+    }
+    // fill the bins (stored contiguously, the elements of bin bb are bin_elements_[bin_offsets_[bb]], ...,
+    // bin_elements_[bin_offsets_[bb + 1] - 1])
+    size_t total_bins = 1;
+    for (size_t dd = 0; dd < d; ++dd)
+      total_bins *= num_bins_[dd];
+    bin_offsets_.assign(total_bins + 1, 0);
+    for (size_t ii = 0; ii < elements_.size(); ++ii)
+      visit_bins(element_lower_lefts[ii], element_upper_rights[ii], [&](const size_t bin) { ++bin_offsets_[bin + 1]; });
+    for (size_t bb = 0; bb < total_bins; ++bb)
+      bin_offsets_[bb + 1] += bin_offsets_[bb];
+    bin_elements_.resize(bin_offsets_[total_bins]);
+    std::vector<size_t> fill(bin_offsets_.begin(), bin_offsets_.end() - 1);
+    for (size_t ii = 0; ii < elements_.size(); ++ii)
+      visit_bins(element_lower_lefts[ii], element_upper_rights[ii], [&](const size_t bin) {
+        bin_elements_[fill[bin]++] = static_cast<uint32_t>(ii);
+      });
+  } // ElementBinSearch(...)
+
+  size_t size() const
+  {
+    return elements_.size();
+  }
+
+  const ElementType& element(const size_t ii) const
+  {
+    return elements_[ii];
+  }
+
+  /// \return the index of an element containing point_in_global_coordinates (see element()), or not_found
+  size_t find(const DomainType& point_in_global_coordinates) const
+  {
+    if (elements_.empty())
+      return not_found;
+    size_t bin = 0;
+    size_t stride = 1;
+    for (size_t dd = 0; dd < d; ++dd) {
+      const auto& xx = point_in_global_coordinates[dd];
+      if (xx < lower_left_[dd] || xx > upper_right_[dd])
+        return not_found;
+      bin += bin_index(xx, dd) * stride;
+      stride *= num_bins_[dd];
+    }
+    for (size_t kk = bin_offsets_[bin]; kk < bin_offsets_[bin + 1]; ++kk) {
+      const auto& element = elements_[bin_elements_[kk]];
+      const auto geometry = element.geometry();
+      if (ReferenceElements<D, d>::general(element.type()).checkInside(geometry.local(point_in_global_coordinates)))
+        return bin_elements_[kk];
+    }
+    return not_found;
+  } // ... find(...)
+
+private:
+  size_t bin_index(const D& xx, const size_t dd) const
+  {
+    const auto index = std::floor((xx - lower_left_[dd]) / bin_width_[dd]);
+    if (index < 0)
+      return 0;
+    return std::min(static_cast<size_t>(index), num_bins_[dd] - 1);
+  }
+
+  template <class VisitorType>
+  void visit_bins(const DomainType& ll, const DomainType& ur, const VisitorType& visitor) const
+  {
+    FieldVector<size_t, d> first;
+    FieldVector<size_t, d> last;
+    for (size_t dd = 0; dd < d; ++dd) {
+      first[dd] = bin_index(ll[dd], dd);
+      last[dd] = bin_index(ur[dd], dd);
+    }
+    FieldVector<size_t, d> current = first;
+    while (true) {
+      size_t bin = 0;
+      size_t stride = 1;
+      for (size_t dd = 0; dd < d; ++dd) {
+        bin += current[dd] * stride;
+        stride *= num_bins_[dd];
+      }
+      visitor(bin);
+      // advance the multi-index
+      size_t dd = 0;
+      while (dd < d && current[dd] == last[dd]) {
+        current[dd] = first[dd];
+        ++dd;
+      }
+      if (dd == d)
+        break;
+      ++current[dd];
+    }
+  } // ... visit_bins(...)
+
+  std::vector<ElementType> elements_;
+  DomainType lower_left_;
+  DomainType upper_right_;
+  FieldVector<size_t, d> num_bins_;
+  DomainType bin_width_;
+  std::vector<size_t> bin_offsets_;
+  std::vector<uint32_t> bin_elements_;
+}; // class ElementBinSearch
+
+
+} // namespace internal
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_ELEMENT_BIN_SEARCH_HH
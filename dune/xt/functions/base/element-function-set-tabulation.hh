@@ -0,0 +1,196 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_ELEMENT_FUNCTION_SET_TABULATION_HH
+#define DUNE_XT_FUNCTIONS_BASE_ELEMENT_FUNCTION_SET_TABULATION_HH
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/xt/functions/interfaces/element-functions.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+
+
+/**
+ * \brief Provides the values and jacobians of a set of element functions at all points of a quadrature, see
+ *        ElementFunctionSetInterface::evaluate_at_points and ElementFunctionSetInterface::jacobians_at_points.
+ *
+ *        If the set is element invariant (see ElementFunctionSetInterface::is_element_invariant) and not parametric,
+ *        its values at the points of a quadrature are computed once for each geometry type and reused on all affine
+ *        elements, as are its jacobians in reference coordinates (which are only transformed with the constant
+ *        jacobian of the geometry of the element). Otherwise, the set is evaluated on each call. Use as in:
+\code
+ElementFunctionSetTabulation<E> tabulation(local_basis);
+for (auto&& element : elements(grid_view)) {
+  local_basis.bind(element);
+  const auto& quadrature = QuadratureRules<double, d>::rule(element.type(), order);
+  const auto& values = tabulation.values(quadrature);
+  ...
+}
+\endcode
+ *
+ * \note The tabulations are identified by the address of the quadrature (and the geometry type of the element), so
+ *       all quadratures have to outlive the tabulation, which is the case for those obtained from QuadratureRules.
+ * \note The returned references are only valid until the next call to values or jacobians.
+ */
+template <class E, size_t r = 1, size_t rC = 1, class R = double>
+class ElementFunctionSetTabulation
+{
+  using ThisType = ElementFunctionSetTabulation<E, r, rC, R>;
+
+public:
+  using ElementFunctionSetType = ElementFunctionSetInterface<E, r, rC, R>;
+  using D = typename ElementFunctionSetType::D;
+  static const constexpr size_t d = ElementFunctionSetType::d;
+  using QuadratureType = QuadratureRule<D, d>;
+
+  ElementFunctionSetTabulation(const ElementFunctionSetType& function_set,
+                               const SetEvaluationLayout layout = SetEvaluationLayout::point_function_component)
+    : function_set_(function_set)
+    , layout_(layout)
+    , num_evaluations_(0)
+  {}
+
+  ElementFunctionSetTabulation(const ThisType& other) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  SetEvaluationLayout layout() const
+  {
+    return layout_;
+  }
+
+  /**
+   * \brief The values of the set (bound to an element) at all points of quadrature, see
+   *        ElementFunctionSetInterface::evaluate_at_points.
+   */
+  const std::vector<R>& values(const QuadratureType& quadrature, const Common::Parameter& param = {})
+  {
+    const size_t size = quadrature.size() * function_set_.size(param) * r * rC;
+    if (!is_reusable(param)) {
+      values_.resize(size);
+      evaluate(quadrature, values_.data(), param);
+      return values_;
+    }
+    auto& tabulation = tabulations_[key(quadrature)];
+    if (tabulation.values.size() != size) {
+      tabulation.values.resize(size);
+      evaluate(quadrature, tabulation.values.data(), param);
+    }
+    return tabulation.values;
+  } // ... values(...)
+
+  /**
+   * \brief The jacobians of the set (bound to an element) at all points of quadrature, see
+   *        ElementFunctionSetInterface::jacobians_at_points.
+   */
+  const std::vector<R>& jacobians(const QuadratureType& quadrature, const Common::Parameter& param = {})
+  {
+    const size_t size = quadrature.size() * function_set_.size(param) * r * rC * d;
+    jacobians_.resize(size);
+    if (!is_reusable(param)) {
+      jacobians_of_set(quadrature, jacobians_.data(), param);
+      return jacobians_;
+    }
+    const auto geometry = function_set_.element().geometry();
+    auto& tabulation = tabulations_[key(quadrature)];
+    if (tabulation.reference_jacobians.size() != size) {
+      // the jacobians of the set are given in global coordinates, transform them back (using J^T = (J^{-T})^{-1})
+      jacobians_of_set(quadrature, jacobians_.data(), param);
+      tabulation.reference_jacobians.resize(size);
+      transform(geometry.jacobianTransposed(quadrature[0].position()), jacobians_, tabulation.reference_jacobians);
+      return jacobians_;
+    }
+    transform(
+        geometry.jacobianInverseTransposed(quadrature[0].position()), tabulation.reference_jacobians, jacobians_);
+    return jacobians_;
+  } // ... jacobians(...)
+
+  /// The number of actual evaluations of the set (of its values or jacobians) at the points of a quadrature.
+  size_t num_evaluations() const
+  {
+    return num_evaluations_;
+  }
+
+  void clear()
+  {
+    tabulations_.clear();
+  }
+
+private:
+  struct Tabulation
+  {
+    std::vector<R> values;
+    std::vector<R> reference_jacobians;
+  }; // struct Tabulation
+
+  using KeyType = std::pair<GeometryType, const QuadratureType*>;
+
+  KeyType key(const QuadratureType& quadrature) const
+  {
+    return {function_set_.element().type(), &quadrature};
+  }
+
+  bool is_reusable(const Common::Parameter& param) const
+  {
+    return !function_set_.is_parametric() && function_set_.is_element_invariant(param)
+           && function_set_.element().geometry().affine();
+  }
+
+  void evaluate(const QuadratureType& quadrature, R* result, const Common::Parameter& param)
+  {
+    function_set_.evaluate_at_points(quadrature, result, layout_, param);
+    ++num_evaluations_;
+  }
+
+  void jacobians_of_set(const QuadratureType& quadrature, R* result, const Common::Parameter& param)
+  {
+    function_set_.jacobians_at_points(quadrature, result, layout_, param);
+    ++num_evaluations_;
+  }
+
+  /// Applies matrix to each consecutive d entries of source (which are the gradients of all components).
+  template <class MatrixType>
+  static void transform(const MatrixType& matrix, const std::vector<R>& source, std::vector<R>& target)
+  {
+    FieldVector<R, d> source_gradient;
+    FieldVector<R, d> target_gradient;
+    for (size_t offset = 0; offset < source.size(); offset += d) {
+      for (size_t dd = 0; dd < d; ++dd)
+        source_gradient[dd] = source[offset + dd];
+      matrix.mv(source_gradient, target_gradient);
+      for (size_t dd = 0; dd < d; ++dd)
+        target[offset + dd] = target_gradient[dd];
+    }
+  } // ... transform(...)
+
+  const ElementFunctionSetType& function_set_;
+  const SetEvaluationLayout layout_;
+  size_t num_evaluations_;
+  std::map<KeyType, Tabulation> tabulations_;
+  std::vector<R> values_;
+  std::vector<R> jacobians_;
+}; // class ElementFunctionSetTabulation
+
+
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_ELEMENT_FUNCTION_SET_TABULATION_HH
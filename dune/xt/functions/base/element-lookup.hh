@@ -0,0 +1,142 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_ELEMENT_LOOKUP_HH
+#define DUNE_XT_FUNCTIONS_BASE_ELEMENT_LOOKUP_HH
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace internal {
+
+
+/**
+ * \brief Holds an entry per element of several grid views, precomputed once so that it can be looked up on bind (see
+ *        CheckerboardFunction::precompute_subdomains() and
+ *        ReinterpretLocalizableFunction::precompute_source_elements()).
+ *
+ *        Precomputing the entries for a grid view replaces those precomputed for the same grid view before, so the
+ *        entries are up to date again after the grid has changed. Copies share the precomputed entries, but are not
+ *        affected by later calls to precompute() or clear() on the original.
+ */
+template <class E, class Entry>
+class ElementLookups
+{
+  class LookupInterface
+  {
+  public:
+    virtual ~LookupInterface() = default;
+
+    /// \return false if element is not contained in the grid view the entries were precomputed for
+    virtual bool lookup(const E& element, Entry& entry) const = 0;
+
+    virtual bool same_grid_view(const LookupInterface& other) const = 0;
+  }; // class LookupInterface
+
+  template <class GV>
+  class Lookup : public LookupInterface
+  {
+  public:
+    template <class ComputeEntry>
+    Lookup(const GV& grid_view,
+           const Entry& default_entry,
+           ComputeEntry&& compute_entry,
+           std::shared_ptr<const void> referenced_data)
+      : grid_view_(grid_view)
+      , mapper_(grid_view_, mcmgElementLayout())
+      , entries_(mapper_.size(), default_entry)
+      , referenced_data_(std::move(referenced_data))
+    {
+      for (auto&& element : elements(grid_view_))
+        compute_entry(element, entries_[mapper_.index(element)]);
+    }
+
+    Lookup(const Lookup&) = delete;
+
+    bool lookup(const E& element, Entry& entry) const override final
+    {
+      if (!grid_view_.indexSet().contains(element))
+        return false;
+      // the grid may have changed since the entries were precomputed
+      const auto index = mapper_.index(element);
+      if (index >= entries_.size())
+        return false;
+      entry = entries_[index];
+      return true;
+    }
+
+    bool same_grid_view(const LookupInterface& other) const override final
+    {
+      const auto* other_lookup = dynamic_cast<const Lookup*>(&other);
+      return (other_lookup != nullptr) && (&other_lookup->grid_view_.indexSet() == &grid_view_.indexSet());
+    }
+
+  private:
+    const GV grid_view_;
+    const MultipleCodimMultipleGeomTypeMapper<GV> mapper_;
+    std::vector<Entry> entries_;
+    const std::shared_ptr<const void> referenced_data_;
+  }; // class Lookup
+
+public:
+  /**
+   * \brief Computes the entry of each element of grid_view, calling compute_entry(element, entry) with entry
+   *        initialized to default_entry.
+   *
+   *        referenced_data is kept alive as long as the entries, in case these point into it.
+   */
+  template <class GV, class ComputeEntry>
+  std::enable_if_t<XT::Grid::is_view<GV>::value && std::is_same<XT::Grid::extract_entity_t<GV>, E>::value, void>
+  precompute(const GV& grid_view,
+             const Entry& default_entry,
+             ComputeEntry&& compute_entry,
+             std::shared_ptr<const void> referenced_data = nullptr)
+  {
+    auto new_lookup = std::make_shared<const Lookup<GV>>(
+        grid_view, default_entry, std::forward<ComputeEntry>(compute_entry), std::move(referenced_data));
+    lookups_.erase(std::remove_if(lookups_.begin(),
+                                  lookups_.end(),
+                                  [&](const auto& lookup) { return new_lookup->same_grid_view(*lookup); }),
+                   lookups_.end());
+    lookups_.emplace_back(std::move(new_lookup));
+  }
+
+  /// \return false if element is not contained in any of the grid views the entries were precomputed for
+  bool lookup(const E& element, Entry& entry) const
+  {
+    for (const auto& element_lookup : lookups_)
+      if (element_lookup->lookup(element, entry))
+        return true;
+    return false;
+  }
+
+  void clear()
+  {
+    lookups_.clear();
+  }
+
+private:
+  std::vector<std::shared_ptr<const LookupInterface>> lookups_;
+}; // class ElementLookups
+
+
+} // namespace internal
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_ELEMENT_LOOKUP_HH
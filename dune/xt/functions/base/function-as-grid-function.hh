@@ -100,11 +100,16 @@ private:
       geometry_ = std::make_unique<GeometryType>(el.geometry());
     }
 
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      bound_function_ = function_.with_parameter(param);
+    }
+
   public:
     int order(const Common::Parameter& param = {}) const override final
     {
       DUNE_THROW_IF(!(geometry_), Exceptions::not_bound_to_an_element_yet, function_.name());
-      return function_.order(param);
+      return function(param).order(param);
     }
 
     using BaseType::evaluate;
@@ -114,7 +119,7 @@ private:
     {
       DUNE_THROW_IF(!(geometry_), Exceptions::not_bound_to_an_element_yet, function_.name());
       this->assert_inside_reference_element(point_in_reference_element);
-      return function_.evaluate(geometry_->global(point_in_reference_element), param);
+      return function(param).evaluate(geometry_->global(point_in_reference_element), param);
     }
 
     using BaseType::jacobian;
@@ -124,7 +129,17 @@ private:
     {
       DUNE_THROW_IF(!(geometry_), Exceptions::not_bound_to_an_element_yet, function_.name());
       this->assert_inside_reference_element(point_in_reference_element);
-      return function_.jacobian(geometry_->global(point_in_reference_element), param);
+      return function(param).jacobian(geometry_->global(point_in_reference_element), param);
+    }
+
+    void evaluate_with_jacobian(const DomainType& point_in_reference_element,
+                                RangeReturnType& value,
+                                DerivativeRangeReturnType& jacobian,
+                                const Common::Parameter& param = {}) const override final
+    {
+      DUNE_THROW_IF(!(geometry_), Exceptions::not_bound_to_an_element_yet, function_.name());
+      this->assert_inside_reference_element(point_in_reference_element);
+      function(param).evaluate_with_jacobian(geometry_->global(point_in_reference_element), value, jacobian, param);
     }
 
     using BaseType::derivative;
@@ -135,12 +150,19 @@ private:
     {
       DUNE_THROW_IF(!(geometry_), Exceptions::not_bound_to_an_element_yet, function_.name());
       this->assert_inside_reference_element(point_in_reference_element);
-      return function_.derivative(alpha, geometry_->global(point_in_reference_element), param);
+      return function(param).derivative(alpha, geometry_->global(point_in_reference_element), param);
     }
 
   private:
+    /// the function with the bound parameter (see bind_parameter), if param is empty
+    const FunctionType& function(const Common::Parameter& param) const
+    {
+      return (bound_function_ && param.empty()) ? *bound_function_ : function_;
+    }
+
     const FunctionType& function_;
     std::unique_ptr<GeometryType> geometry_;
+    std::unique_ptr<const FunctionType> bound_function_;
   }; // class LocalFunction
 
   XT::Common::ConstStorageProvider<FunctionType> function_storage_;
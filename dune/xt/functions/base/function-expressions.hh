@@ -0,0 +1,260 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_FUNCTION_EXPRESSIONS_HH
+#define DUNE_XT_FUNCTIONS_BASE_FUNCTION_EXPRESSIONS_HH
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <dune/xt/functions/base/combined-functions.hh>
+#include <dune/xt/functions/interfaces/function.hh>
+#include <dune/xt/functions/type_traits.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace internal {
+
+
+/// \brief Base of all function expressions, see expression().
+struct FunctionExpressionTag
+{};
+
+
+template <class T>
+struct is_function_expression : public std::is_base_of<FunctionExpressionTag, std::decay_t<T>>
+{};
+
+
+/**
+ * \brief Sub-expressions are stored by value (they are cheap to copy and usually temporaries), all other functions by
+ *        reference.
+ */
+template <class T>
+using FunctionExpressionStorage = std::conditional_t<is_function_expression<T>::value, const T, const T&>;
+
+
+/**
+ * \brief Combination of two functions within a function expression, see expression().
+ *
+ *        As opposed to CombinedFunction, the static types of both operands are kept, so all calls within an
+ *        expression are resolved at compile time (given that the final overrides of the functions involved are used,
+ *        as is the case for all functions in dune-xt-functions) and may thus be inlined.
+ */
+template <class LeftType, class RightType, CombinationType comb>
+class CombinedFunctionExpression
+  : public FunctionInterface<LeftType::domain_dim,
+                             SelectCombined<LeftType, RightType, comb>::r,
+                             SelectCombined<LeftType, RightType, comb>::rC,
+                             typename SelectCombined<LeftType, RightType, comb>::R>
+  , public FunctionExpressionTag
+{
+  using BaseType = FunctionInterface<LeftType::domain_dim,
+                                     SelectCombined<LeftType, RightType, comb>::r,
+                                     SelectCombined<LeftType, RightType, comb>::rC,
+                                     typename SelectCombined<LeftType, RightType, comb>::R>;
+  using ThisType = CombinedFunctionExpression<LeftType, RightType, comb>;
+  using Select = SelectCombined<LeftType, RightType, comb>;
+
+public:
+  using typename BaseType::DerivativeRangeReturnType;
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeReturnType;
+
+  template <class L, class R>
+  CombinedFunctionExpression(L&& left, R&& right)
+    : left_(std::forward<L>(left))
+    , right_(std::forward<R>(right))
+  {
+    static_assert(is_function_expression<L>::value || std::is_lvalue_reference<L>::value,
+                  "Functions which are not expressions are stored by reference and have to outlive the expression, "
+                  "temporaries are not allowed!");
+    static_assert(is_function_expression<R>::value || std::is_lvalue_reference<R>::value,
+                  "Functions which are not expressions are stored by reference and have to outlive the expression, "
+                  "temporaries are not allowed!");
+  }
+
+  CombinedFunctionExpression(const ThisType& other) = default;
+  CombinedFunctionExpression(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  std::string name() const override final
+  {
+    return Select::type() + " of '" + left_.name() + "' and '" + right_.name() + "'";
+  }
+
+  int order(const XT::Common::Parameter& param = {}) const override final
+  {
+    auto ret = Select::order(left_.order(param), right_.order(param));
+    assert(ret < std::numeric_limits<int>::max());
+    return static_cast<int>(ret);
+  }
+
+  RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                           const Common::Parameter& param = {}) const override final
+  {
+    return Select::evaluate(left_, right_, point_in_global_coordinates, param);
+  }
+
+  DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
+                                     const Common::Parameter& param = {}) const override final
+  {
+    return Select::jacobian(left_, right_, point_in_global_coordinates, param);
+  }
+
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& param = {}) const override final
+  {
+    Select::evaluate_with_jacobian(left_, right_, point_in_global_coordinates, value, jacobian, param);
+  }
+
+private:
+  FunctionExpressionStorage<LeftType> left_;
+  FunctionExpressionStorage<RightType> right_;
+}; // class CombinedFunctionExpression
+
+
+template <class L, class R>
+struct are_function_expression_operands
+  : public std::integral_constant<bool,
+                                  is_function<std::decay_t<L>>::value && is_function<std::decay_t<R>>::value
+                                      && (is_function_expression<L>::value || is_function_expression<R>::value)>
+{};
+
+
+} // namespace internal
+
+
+/**
+ * \brief Leaf of a function expression, wrapping a reference to a function, see expression().
+ */
+template <class FunctionType>
+class FunctionExpression
+  : public FunctionInterface<FunctionType::d, FunctionType::r, FunctionType::rC, typename FunctionType::R>
+  , public internal::FunctionExpressionTag
+{
+  using BaseType = FunctionInterface<FunctionType::d, FunctionType::r, FunctionType::rC, typename FunctionType::R>;
+  using ThisType = FunctionExpression<FunctionType>;
+
+public:
+  using typename BaseType::DerivativeRangeReturnType;
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeReturnType;
+
+  explicit FunctionExpression(const FunctionType& function)
+    : BaseType(function.parameter_type())
+    , function_(function)
+  {}
+
+  FunctionExpression(const ThisType& other) = default;
+  FunctionExpression(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  std::string name() const override final
+  {
+    return function_.name();
+  }
+
+  int order(const XT::Common::Parameter& param = {}) const override final
+  {
+    return function_.order(param);
+  }
+
+  RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                           const Common::Parameter& param = {}) const override final
+  {
+    return function_.evaluate(point_in_global_coordinates, param);
+  }
+
+  DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
+                                     const Common::Parameter& param = {}) const override final
+  {
+    return function_.jacobian(point_in_global_coordinates, param);
+  }
+
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& param = {}) const override final
+  {
+    function_.evaluate_with_jacobian(point_in_global_coordinates, value, jacobian, param);
+  }
+
+private:
+  const FunctionType& function_;
+}; // class FunctionExpression
+
+
+/**
+ * \brief Starts a function expression, in which sums, differences and products of functions keep the static types of
+ *        their operands, to be evaluated without virtual calls in between.
+ *
+ *        Using operator+, operator- or operator* on FunctionInterface, the function a * b + c - d results in four
+ *        functions, each calling the next by a virtual call. Using
+\code
+const auto coefficient = expression(a) * b + c - d;
+\endcode
+ *        instead results in a single function, whose evaluate and jacobian only require a single virtual call (if used
+ *        as a FunctionInterface at all). It is sufficient if one operand of each operation is an expression.
+ *
+ * \note  Sub-expressions are stored by value, but all other operands by reference (as in CombinedFunction): these have
+ *        to outlive the expression, so temporaries are rejected at compile time.
+ */
+template <class FunctionType>
+std::enable_if_t<is_function<FunctionType>::value, FunctionExpression<FunctionType>>
+expression(const FunctionType& function)
+{
+  return FunctionExpression<FunctionType>(function);
+}
+
+/// \brief The function is stored by reference, so temporaries are not allowed, see above.
+template <class FunctionType>
+std::enable_if_t<is_function<FunctionType>::value, FunctionExpression<FunctionType>>
+expression(const FunctionType&& function) = delete;
+
+
+template <class L, class R>
+std::enable_if_t<internal::are_function_expression_operands<L, R>::value,
+                 internal::CombinedFunctionExpression<std::decay_t<L>, std::decay_t<R>, CombinationType::difference>>
+operator-(L&& left, R&& right)
+{
+  return {std::forward<L>(left), std::forward<R>(right)};
+}
+
+
+template <class L, class R>
+std::enable_if_t<internal::are_function_expression_operands<L, R>::value,
+                 internal::CombinedFunctionExpression<std::decay_t<L>, std::decay_t<R>, CombinationType::sum>>
+operator+(L&& left, R&& right)
+{
+  return {std::forward<L>(left), std::forward<R>(right)};
+}
+
+
+template <class L, class R>
+std::enable_if_t<internal::are_function_expression_operands<L, R>::value,
+                 internal::CombinedFunctionExpression<std::decay_t<L>, std::decay_t<R>, CombinationType::product>>
+operator*(L&& left, R&& right)
+{
+  return {std::forward<L>(left), std::forward<R>(right)};
+}
+
+
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_FUNCTION_EXPRESSIONS_HH
@@ -0,0 +1,96 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_PARAMETER_BOUND_FUNCTION_HH
+#define DUNE_XT_FUNCTIONS_BASE_PARAMETER_BOUND_FUNCTION_HH
+
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/xt/functions/interfaces/function.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+
+
+/**
+ * \brief A function with a fixed parameter, see FunctionInterface::with_parameter.
+ *
+ *        The parameter is parsed once, and passed to each evaluation of the given function (instead of the parameter
+ *        given to the evaluation, which is ignored).
+ */
+template <class FunctionType>
+class ParameterBoundFunction
+  : public FunctionInterface<FunctionType::d, FunctionType::r, FunctionType::rC, typename FunctionType::R>
+{
+  using BaseType = FunctionInterface<FunctionType::d, FunctionType::r, FunctionType::rC, typename FunctionType::R>;
+  using ThisType = ParameterBoundFunction<FunctionType>;
+
+public:
+  using BaseType::d;
+  using typename BaseType::DerivativeRangeReturnType;
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeReturnType;
+
+  ParameterBoundFunction(const FunctionType& function, const Common::Parameter& param)
+    : function_(function)
+    , param_(function_.parse_parameter(param))
+  {}
+
+  ParameterBoundFunction(const ThisType& other) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  std::string name() const override final
+  {
+    return function_.name();
+  }
+
+  int order(const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    return function_.order(param_);
+  }
+
+  RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                           const Common::Parameter& /*param*/ = {}) const override final
+  {
+    return function_.evaluate(point_in_global_coordinates, param_);
+  }
+
+  DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
+                                     const Common::Parameter& /*param*/ = {}) const override final
+  {
+    return function_.jacobian(point_in_global_coordinates, param_);
+  }
+
+  DerivativeRangeReturnType derivative(const std::array<size_t, d>& alpha,
+                                       const DomainType& point_in_global_coordinates,
+                                       const Common::Parameter& /*param*/ = {}) const override final
+  {
+    return function_.derivative(alpha, point_in_global_coordinates, param_);
+  }
+
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
+  {
+    function_.evaluate_with_jacobian(point_in_global_coordinates, value, jacobian, param_);
+  }
+
+private:
+  const FunctionType& function_;
+  const Common::Parameter param_;
+}; // class ParameterBoundFunction
+
+
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_PARAMETER_BOUND_FUNCTION_HH
@@ -13,10 +13,15 @@
 #ifndef DUNE_XT_FUNCTION_BASE_REINTERPRET_HH
 #define DUNE_XT_FUNCTION_BASE_REINTERPRET_HH
 
+#include <memory>
+#include <vector>
+
 #include <dune/geometry/referenceelements.hh>
 
 #include <dune/xt/grid/search.hh>
 
+#include <dune/xt/functions/base/element-bin-search.hh>
+#include <dune/xt/functions/base/element-lookup.hh>
 #include <dune/xt/functions/exceptions.hh>
 #include <dune/xt/functions/interfaces/grid-function.hh>
 
@@ -32,6 +37,9 @@ namespace Functions {
  *        local_function to provide an evaluation for a point on the new grid layer. Zero is returned if no element is
  *        found. The physical domain covered by the new grid layer should thus be contained in the physical domain of
  *        the original grid layer. This is mainly used in the context of prolongations.
+ *
+ *        The source elements are searched for on each bind of a local function, unless they have been precomputed for
+ *        a grid view containing the target element, see precompute_source_elements().
  */
 template <class SourceGridView,
           class TargetElement = XT::Grid::extract_entity_t<SourceGridView>,
@@ -53,6 +61,21 @@ public:
 
   using SourceType = GridFunctionInterface<XT::Grid::extract_entity_t<SourceGridView>, r, rC, R>;
 
+private:
+  using SourceElementType = XT::Grid::extract_entity_t<SourceGridView>;
+  using SourceSearchType = internal::ElementBinSearch<SourceGridView>;
+
+  struct SourceElementEntry
+  {
+    /// points into the SourceSearchType the entry was computed with, nullptr if the search failed for the first vertex
+    /// of the target element
+    const SourceElementType* source_element;
+    bool contains_target_element;
+  };
+
+  using SourceElementLookupsType = internal::ElementLookups<TargetElement, SourceElementEntry>;
+
+public:
   static std::string static_id()
   {
     return BaseType::static_id() + ".reinterpret";
@@ -66,7 +89,50 @@ public:
 
   std::unique_ptr<LocalFunctionType> local_function() const override final
   {
-    return std::make_unique<ReinterpretLocalfunction>(source_, source_grid_view_);
+    return std::make_unique<ReinterpretLocalfunction>(
+        source_, source_grid_view_, source_search_, source_element_lookups_);
+  }
+
+  /**
+   * \brief Determines the source elements for each element of target_grid_view once (using a spatial index of the
+   *        source elements, see internal::ElementBinSearch), so that binding a local function to one of these elements
+   *        amounts to a lookup.
+   *
+   * \note Only affects local functions obtained afterwards, and has to be called again if one of the grids changes
+   *       (which replaces the source elements precomputed for target_grid_view before). Local functions obtained
+   *       afterwards also use the rebuilt spatial index to search for source elements on evaluation.
+   */
+  template <class TargetGridView>
+  std::enable_if_t<XT::Grid::is_view<TargetGridView>::value
+                       && std::is_same<XT::Grid::extract_entity_t<TargetGridView>, TargetElement>::value,
+                   void>
+  precompute_source_elements(const TargetGridView& target_grid_view)
+  {
+    // the source grid may have changed since the last call
+    source_search_ = std::make_shared<const SourceSearchType>(source_grid_view_);
+    using D = typename SourceSearchType::D;
+    static const constexpr int d = SourceSearchType::d;
+    const auto& source_search = *source_search_;
+    source_element_lookups_.precompute(
+        target_grid_view,
+        SourceElementEntry{nullptr, false},
+        [&](const auto& target_element, SourceElementEntry& entry) {
+          // as in ReinterpretLocalfunction::post_bind, use the source element containing the first vertex and check
+          // if it contains the others
+          const auto target_geometry = target_element.geometry();
+          const auto source_element_index = source_search.find(target_geometry.corner(0));
+          if (source_element_index == SourceSearchType::not_found)
+            return;
+          const auto& source_element = source_search.element(source_element_index);
+          const auto source_geometry = source_element.geometry();
+          const auto& source_reference_element = ReferenceElements<D, d>::general(source_element.type());
+          entry.source_element = &source_element;
+          entry.contains_target_element = true;
+          for (int ii = 1; ii < target_geometry.corners(); ++ii)
+            if (!source_reference_element.checkInside(source_geometry.local(target_geometry.corner(ii))))
+              entry.contains_target_element = false;
+        },
+        source_search_);
   }
 
   std::string name() const
@@ -86,10 +152,15 @@ private:
     using typename BaseType::DomainType;
     using typename BaseType::RangeReturnType;
 
-    ReinterpretLocalfunction(const SourceType& source, const SourceGridView& source_grid_view)
+    ReinterpretLocalfunction(const SourceType& source,
+                             const SourceGridView& source_grid_view,
+                             const std::shared_ptr<const SourceSearchType>& source_search,
+                             const SourceElementLookupsType& source_element_lookups)
       : BaseType(source.parameter_type())
       , source_(source)
       , source_grid_view_(source_grid_view)
+      , source_search_(source_search)
+      , source_element_lookups_(source_element_lookups)
       , source_element_search_(source_grid_view_)
       , local_source_(source_.local_function())
       , source_element_which_contains_complete_target_element_(nullptr)
@@ -100,6 +171,24 @@ private:
   protected:
     void post_bind(const TargetElement& target_element)
     {
+      SourceElementEntry entry;
+      if (source_element_lookups_.lookup(target_element, entry)) {
+        if (entry.source_element == nullptr) { // The search failed, local_source_valid_for_this_point_ is false
+          source_element_which_contains_complete_target_element_ = nullptr;
+          source_element_which_contains_some_point_of_target_element_ = nullptr;
+          return;
+        }
+        const auto& source_element = *entry.source_element;
+        if (entry.contains_target_element) {
+          assign(source_element_which_contains_complete_target_element_, source_element);
+          source_element_which_contains_some_point_of_target_element_ = nullptr;
+        } else {
+          source_element_which_contains_complete_target_element_ = nullptr;
+          assign(source_element_which_contains_some_point_of_target_element_, source_element);
+        }
+        local_source_->bind(source_element);
+        return;
+      }
       // See if we find a source element which contais target_element completely. Therefore
       // * collect all vertices
       const auto& reference_element = ReferenceElements<D, d>::general(target_element.geometry().type());
@@ -139,6 +228,11 @@ private:
       }
     } // ... post_bind(...)
 
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      local_source_->bind_parameter(param);
+    }
+
   public:
     /**
      * \note In some special situations (e.g., if the target element is not completely contained in one source
@@ -200,6 +294,16 @@ private:
         local_source_valid_for_this_point_ = true;
         return;
       }
+      if (source_search_) {
+        const auto source_element =
+            source_search_->find(this->element().geometry().global(point_in_target_reference_element));
+        if (source_element != SourceSearchType::not_found) {
+          assign(source_element_which_contains_some_point_of_target_element_, source_search_->element(source_element));
+          local_source_->bind(*source_element_which_contains_some_point_of_target_element_);
+          local_source_valid_for_this_point_ = true;
+        }
+        return;
+      }
       if (single_point_.size() != 1)
         single_point_.resize(1);
       single_point_[0] = this->element().geometry().global(point_in_target_reference_element);
@@ -214,8 +318,18 @@ private:
       }
     } // ... try_to_bind_local_source_for_this_point(...)
 
+    static void assign(std::unique_ptr<SourceElementType>& ptr, const SourceElementType& source_element)
+    {
+      if (ptr)
+        *ptr = source_element;
+      else
+        ptr = std::make_unique<SourceElementType>(source_element);
+    }
+
     const SourceType& source_;
     const SourceGridView& source_grid_view_;
+    const std::shared_ptr<const SourceSearchType> source_search_;
+    const SourceElementLookupsType source_element_lookups_;
     mutable XT::Grid::EntityInlevelSearch<SourceGridView> source_element_search_;
     mutable std::unique_ptr<typename SourceType::LocalFunctionType> local_source_;
     mutable std::unique_ptr<XT::Grid::extract_entity_t<SourceGridView>>
@@ -229,6 +343,8 @@ private:
 
   const SourceType& source_;
   const SourceGridView& source_grid_view_;
+  std::shared_ptr<const SourceSearchType> source_search_;
+  SourceElementLookupsType source_element_lookups_;
 }; // class ReinterpretLocalizableFunction
 
 
@@ -0,0 +1,179 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_BASE_SCALED_IDENTITY_HH
+#define DUNE_XT_FUNCTIONS_BASE_SCALED_IDENTITY_HH
+
+#include <dune/xt/common/memory.hh>
+
+#include <dune/xt/functions/interfaces/grid-function.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+
+
+/**
+ * \brief Models x -> f(x) * I, given a scalar grid function f, where I denotes the r x r unit matrix.
+ *
+ *        This is equivalent to the product of f with a constant unit matrix, but each evaluation amounts to a single
+ *        evaluation of f (and the jacobian is given by the gradient of f on the diagonal).
+ */
+template <class E, size_t r, class R = double>
+class ScaledIdentityGridFunction : public GridFunctionInterface<E, r, r, R>
+{
+  using BaseType = GridFunctionInterface<E, r, r, R>;
+  using ThisType = ScaledIdentityGridFunction<E, r, R>;
+
+public:
+  using ScalarFunctionType = GridFunctionInterface<E, 1, 1, R>;
+
+private:
+  class ScaledIdentityLocalFunction : public ElementFunctionInterface<E, r, r, R>
+  {
+    using InterfaceType = ElementFunctionInterface<E, r, r, R>;
+    using ScalarLocalFunctionType = typename ScalarFunctionType::LocalFunctionType;
+
+    template <size_t r_ = r, bool anything = true>
+    struct expand
+    {
+      static void value(const typename ScalarLocalFunctionType::RangeReturnType& scalar_value,
+                        typename InterfaceType::RangeReturnType& ret)
+      {
+        for (size_t rr = 0; rr < r; ++rr)
+          for (size_t cc = 0; cc < r; ++cc)
+            ret[rr][cc] = (rr == cc) ? scalar_value[0] : R(0);
+      }
+
+      static void jacobian(const typename ScalarLocalFunctionType::DerivativeRangeReturnType& scalar_jacobian,
+                           typename InterfaceType::DerivativeRangeReturnType& ret)
+      {
+        for (size_t rr = 0; rr < r; ++rr) {
+          ret[rr] = 0;
+          ret[rr][rr] = scalar_jacobian[0];
+        }
+      }
+    }; // struct expand<r, ...>
+
+    template <bool anything>
+    struct expand<1, anything>
+    {
+      static void value(const typename ScalarLocalFunctionType::RangeReturnType& scalar_value,
+                        typename InterfaceType::RangeReturnType& ret)
+      {
+        ret = scalar_value;
+      }
+
+      static void jacobian(const typename ScalarLocalFunctionType::DerivativeRangeReturnType& scalar_jacobian,
+                           typename InterfaceType::DerivativeRangeReturnType& ret)
+      {
+        ret = scalar_jacobian;
+      }
+    }; // struct expand<1, ...>
+
+  public:
+    using typename InterfaceType::DerivativeRangeReturnType;
+    using typename InterfaceType::DomainType;
+    using typename InterfaceType::ElementType;
+    using typename InterfaceType::RangeReturnType;
+
+    ScaledIdentityLocalFunction(const ScalarFunctionType& scalar_function)
+      : InterfaceType(scalar_function.parameter_type())
+      , scalar_local_function_(scalar_function.local_function())
+    {}
+
+  protected:
+    void post_bind(const ElementType& element) override final
+    {
+      scalar_local_function_->bind(element);
+    }
+
+    void post_bind_parameter(const Common::Parameter& param) override final
+    {
+      scalar_local_function_->bind_parameter(param);
+    }
+
+  public:
+    int order(const XT::Common::Parameter& param = {}) const override final
+    {
+      return scalar_local_function_->order(param);
+    }
+
+    RangeReturnType evaluate(const DomainType& point_in_reference_element,
+                             const Common::Parameter& param = {}) const override final
+    {
+      RangeReturnType ret;
+      expand<>::value(scalar_local_function_->evaluate(point_in_reference_element, param), ret);
+      return ret;
+    }
+
+    DerivativeRangeReturnType jacobian(const DomainType& point_in_reference_element,
+                                       const Common::Parameter& param = {}) const override final
+    {
+      DerivativeRangeReturnType ret;
+      expand<>::jacobian(scalar_local_function_->jacobian(point_in_reference_element, param), ret);
+      return ret;
+    }
+
+    void evaluate_with_jacobian(const DomainType& point_in_reference_element,
+                                RangeReturnType& value,
+                                DerivativeRangeReturnType& jacobian,
+                                const Common::Parameter& param = {}) const override final
+    {
+      typename ScalarLocalFunctionType::RangeReturnType scalar_value;
+      typename ScalarLocalFunctionType::DerivativeRangeReturnType scalar_jacobian;
+      scalar_local_function_->evaluate_with_jacobian(point_in_reference_element, scalar_value, scalar_jacobian, param);
+      expand<>::value(scalar_value, value);
+      expand<>::jacobian(scalar_jacobian, jacobian);
+    }
+
+  private:
+    std::unique_ptr<ScalarLocalFunctionType> scalar_local_function_;
+  }; // class ScaledIdentityLocalFunction
+
+public:
+  using typename BaseType::LocalFunctionType;
+
+  ScaledIdentityGridFunction(const ScalarFunctionType& scalar_function, const std::string nm = "")
+    : BaseType(scalar_function.parameter_type())
+    , scalar_function_(scalar_function)
+    , name_(nm)
+  {}
+
+  ScaledIdentityGridFunction(ScalarFunctionType*&& scalar_function_ptr, const std::string nm = "")
+    : BaseType(scalar_function_ptr->parameter_type())
+    , scalar_function_(std::move(scalar_function_ptr))
+    , name_(nm)
+  {}
+
+  ScaledIdentityGridFunction(const ThisType& other) = default;
+  ScaledIdentityGridFunction(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  std::unique_ptr<LocalFunctionType> local_function() const override final
+  {
+    return std::make_unique<ScaledIdentityLocalFunction>(scalar_function_.access());
+  }
+
+  std::string name() const override final
+  {
+    return name_.empty() ? scalar_function_.access().name() : name_;
+  }
+
+private:
+  const Common::ConstStorageProvider<ScalarFunctionType> scalar_function_;
+  const std::string name_;
+}; // class ScaledIdentityGridFunction
+
+
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_BASE_SCALED_IDENTITY_HH
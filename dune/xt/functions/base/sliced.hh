@@ -75,10 +75,15 @@ class SlicedGridFunction<LF, r, 1> : public XT::Functions::GridFunctionInterface
       local_function_->bind(element);
     }
 
+    void post_bind_parameter(const XT::Common::Parameter& param) override final
+    {
+      local_function_->bind_parameter(param);
+    }
+
   public:
-    int order(const XT::Common::Parameter& = {}) const override final
+    int order(const XT::Common::Parameter& param = {}) const override final
     {
-      return local_function_->order();
+      return local_function_->order(param);
     }
 
     RangeReturnType evaluate(const DomainType& xx, const XT::Common::Parameter& param = {}) const override final
@@ -81,6 +81,11 @@ class TransformedGridFunction : public XT::Functions::GridFunctionInterface<type
       local_function_->bind(element);
     }
 
+    void post_bind_parameter(const XT::Common::Parameter& param) override final
+    {
+      local_function_->bind_parameter(param);
+    }
+
   public:
     int order(const XT::Common::Parameter& param = {}) const override final
     {
@@ -14,14 +14,29 @@
 #define DUNE_XT_FUNCTIONS_BASE_VISUALIZATION_HH
 
 #include <algorithm>
-
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/grid/io/file/vtk/common.hh>
 #include <dune/grid/io/file/vtk/function.hh>
 
+#include <dune/xt/common/filesystem.hh>
 #include <dune/xt/common/numeric_cast.hh>
 #include <dune/xt/common/memory.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
 #include <dune/xt/common/parameter.hh>
+#include <dune/xt/common/string.hh>
 
 #include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/exceptions.hh>
 #include <dune/xt/functions/type_traits.hh>
 
 namespace Dune {
@@ -180,6 +195,60 @@ private:
 }; // class GenericVisualizer
 
 
+namespace internal {
+
+
+/**
+ * \brief Binds a local function to the elements VTKWriter asks for, caching its value (or jacobian) at the last point.
+ *
+ *        VTKWriter calls VTKFunction::evaluate once per component for each vertex (or element), so without caching a
+ *        matrix-valued function would be bound and evaluated r * rC times for each vertex of each element.
+ */
+template <class LocalFunctionType, class ValueType>
+class CachingLocalFunctionEvaluator
+{
+  using ElementType = typename LocalFunctionType::ElementType;
+  using DomainType = typename LocalFunctionType::DomainType;
+
+public:
+  CachingLocalFunctionEvaluator(std::unique_ptr<LocalFunctionType>&& local_function)
+    : local_function_(std::move(local_function))
+    , element_(nullptr)
+    , value_is_valid_(false)
+  {}
+
+  template <class EvaluationType>
+  const ValueType&
+  evaluate(const ElementType& element, const DomainType& point_in_reference_element, EvaluationType eval)
+  {
+    if (!element_ || *element_ != element) {
+      if (element_)
+        *element_ = element;
+      else
+        element_ = std::make_unique<ElementType>(element);
+      local_function_->bind(*element_);
+      value_is_valid_ = false;
+    }
+    if (!value_is_valid_ || point_ != point_in_reference_element) {
+      value_ = eval(*local_function_, point_in_reference_element);
+      point_ = point_in_reference_element;
+      value_is_valid_ = true;
+    }
+    return value_;
+  } // ... evaluate(...)
+
+private:
+  std::unique_ptr<LocalFunctionType> local_function_;
+  std::unique_ptr<ElementType> element_;
+  DomainType point_;
+  ValueType value_;
+  bool value_is_valid_;
+}; // class CachingLocalFunctionEvaluator
+
+
+} // namespace internal
+
+
 template <class GridViewType, size_t range_dim, size_t range_dim_cols, class RangeField>
 class VisualizationAdapter : public VTKFunction<GridViewType>
 {
@@ -192,13 +261,15 @@ public:
 private:
   using LocalFunctionType = typename GridFunctionType::LocalFunctionType;
   using DomainType = typename LocalFunctionType::DomainType;
+  using EvaluatorType =
+      internal::CachingLocalFunctionEvaluator<LocalFunctionType, typename LocalFunctionType::RangeReturnType>;
 
 public:
   VisualizationAdapter(const GridFunctionType& localizable_function,
                        const VisualizerInterface<range_dim, range_dim_cols, RangeField>& visualizer,
                        const std::string nm = "",
                        const XT::Common::Parameter& param = {})
-    : local_function_(localizable_function.local_function())
+    : evaluator_(localizable_function.local_function())
     , visualizer_(visualizer)
     , name_(nm.empty() ? localizable_function.name() : nm)
     , param_(param)
@@ -207,7 +278,7 @@ public:
   VisualizationAdapter(const GridFunctionType& localizable_function,
                        const std::string nm = "",
                        const XT::Common::Parameter& param = {})
-    : local_function_(localizable_function.local_function())
+    : evaluator_(localizable_function.local_function())
     , visualizer_(new DefaultVisualizer<range_dim, range_dim_cols, RangeField>())
     , name_(nm.empty() ? localizable_function.name() : nm)
     , param_(param)
@@ -225,13 +296,14 @@ public:
 
   double evaluate(int comp, const EntityType& en, const DomainType& xx) const override final
   {
-    local_function_->bind(en);
-    const auto value = local_function_->evaluate(xx, param_);
+    const auto& value = evaluator_.evaluate(en, xx, [&](const LocalFunctionType& local_function, const DomainType& x) {
+      return local_function.evaluate(x, param_);
+    });
     return visualizer_.access().evaluate(comp, value);
   }
 
 private:
-  mutable std::unique_ptr<LocalFunctionType> local_function_;
+  mutable EvaluatorType evaluator_;
   const Common::ConstStorageProvider<VisualizerInterface<range_dim, range_dim_cols, RangeField>> visualizer_;
   const std::string name_;
   const XT::Common::Parameter param_;
@@ -251,13 +323,15 @@ public:
 private:
   using LocalFunctionType = typename GridFunctionType::LocalFunctionType;
   using DomainType = typename LocalFunctionType::DomainType;
+  using EvaluatorType =
+      internal::CachingLocalFunctionEvaluator<LocalFunctionType, typename LocalFunctionType::DerivativeRangeReturnType>;
 
 public:
   GradientVisualizationAdapter(const GridFunctionType& localizable_function,
                                const VisualizerInterface<d, 1, RangeField>& visualizer,
                                const std::string nm = "",
                                const XT::Common::Parameter& param = {})
-    : local_function_(localizable_function.local_function())
+    : evaluator_(localizable_function.local_function())
     , visualizer_(visualizer)
     , name_(nm.empty() ? "grad_" + localizable_function.name() : nm)
     , param_(param)
@@ -269,7 +343,7 @@ public:
   GradientVisualizationAdapter(const GridFunctionType& localizable_function,
                                const std::string nm = "",
                                const XT::Common::Parameter& param = {})
-    : local_function_(localizable_function.local_function())
+    : evaluator_(localizable_function.local_function())
     , visualizer_(new DefaultVisualizer<d, 1, RangeField>())
     , name_(nm.empty() ? "grad_" + localizable_function.name() : nm)
     , param_(param)
@@ -290,19 +364,471 @@ public:
 
   double evaluate(int comp, const EntityType& en, const DomainType& xx) const override final
   {
-    local_function_->bind(en);
-    const auto value = local_function_->jacobian(xx, param_);
+    const auto& value = evaluator_.evaluate(en, xx, [&](const LocalFunctionType& local_function, const DomainType& x) {
+      return local_function.jacobian(x, param_);
+    });
     return visualizer_.access().evaluate(comp, value[0]);
   }
 
 private:
-  mutable std::unique_ptr<LocalFunctionType> local_function_;
+  mutable EvaluatorType evaluator_;
   const Common::ConstStorageProvider<VisualizerInterface<d, 1, RangeField>> visualizer_;
   const std::string name_;
   const XT::Common::Parameter param_;
 }; // class GradientVisualizationAdapter
 
 
+/// \brief A function whose gradient is to be visualized (under name, if not empty), see gradient_of().
+template <class FunctionType>
+struct VisualizedGradient
+{
+  const FunctionType& function;
+  const std::string name;
+};
+
+
+/// \brief Marks the gradient of function (instead of its values) to be visualized by visualize(grid_view, path, ...).
+template <class FunctionType>
+VisualizedGradient<FunctionType> gradient_of(const FunctionType& function, const std::string nm = "")
+{
+  return {function, nm};
+}
+
+
+/**
+ * \brief Writes grid functions to a VTK unstructured grid file (.vtu), evaluating them in parallel in a single pass
+ *        over the grid.
+ *
+ *        As with VTKWriter and VTK::nonconforming, each element is written with its own corners: functions added by
+ *        add_function() are evaluated at the corners of each element (point data), gradients added by add_gradient()
+ *        at the center of each element (cell data). All values and coordinates are written as Float32.
+ *
+ *        The data is written as appended raw binary data, the position of each value in the file is thus known in
+ *        advance: the elements are processed in chunks (of chunk_size elements per thread), each chunk is evaluated in
+ *        parallel into a buffer which is then written to its final position in the file, so memory usage does not
+ *        depend on the size of the grid.
+ *
+ *        Usage:
+\code
+ParallelVTUWriter<GV> writer(grid_view);
+writer.add_function(pressure);
+writer.add_function(permeability, "kappa");
+writer.add_gradient(pressure);
+writer.write("solution"); // writes solution.vtu, or solution.pvtu and solution-p{rank}.vtu in parallel runs
+\endcode
+ *
+ * \note The functions (and visualizers) are referenced and have to exist until write() is called.
+ * \note Compressed output is not supported.
+ */
+template <class GridViewType>
+class ParallelVTUWriter
+{
+  static_assert(XT::Grid::is_view<GridViewType>::value, "");
+  using ThisType = ParallelVTUWriter<GridViewType>;
+
+public:
+  using ElementType = XT::Grid::extract_entity_t<GridViewType>;
+  using D = typename ElementType::Geometry::ctype;
+  static const constexpr size_t d = ElementType::dimension;
+  using DomainType = FieldVector<D, d>;
+
+private:
+  using AdapterType = VTKFunction<GridViewType>;
+
+  struct Field
+  {
+    std::string name;
+    int ncomps;
+    bool is_cell_data;
+    // creates an adapter (holding a local function) for each thread
+    std::function<std::unique_ptr<AdapterType>()> create_adapter;
+  };
+
+  struct Array
+  {
+    size_t offset; // w.r.t. the start of the appended data
+    size_t entry_size; // in bytes
+  };
+
+public:
+  ParallelVTUWriter(const GridViewType& grid_view,
+                    const size_t num_threads = Common::threadManager().max_threads(),
+                    const size_t chunk_size = 4096)
+    : grid_view_(grid_view)
+    , num_threads_(std::max(num_threads, size_t(1)))
+    , chunk_size_(std::max(chunk_size, size_t(1)))
+  {}
+
+  ParallelVTUWriter(const ThisType& other) = delete;
+  ParallelVTUWriter(ThisType&& source) = default;
+
+  ThisType& operator=(const ThisType& other) = delete;
+  ThisType& operator=(ThisType&& source) = delete;
+
+  template <size_t r, size_t rC, class R>
+  ThisType& add_function(const GridFunctionInterface<ElementType, r, rC, R>& function,
+                         const VisualizerInterface<r, rC, R>& visualizer,
+                         const std::string nm = "",
+                         const XT::Common::Parameter& param = {})
+  {
+    return add_field(false, [&function, &visualizer, nm, param]() -> std::unique_ptr<AdapterType> {
+      return std::make_unique<VisualizationAdapter<GridViewType, r, rC, R>>(function, visualizer, nm, param);
+    });
+  }
+
+  template <size_t r, size_t rC, class R>
+  ThisType& add_function(const GridFunctionInterface<ElementType, r, rC, R>& function,
+                         const std::string nm = "",
+                         const XT::Common::Parameter& param = {})
+  {
+    return add_field(false, [&function, nm, param]() -> std::unique_ptr<AdapterType> {
+      return std::make_unique<VisualizationAdapter<GridViewType, r, rC, R>>(function, nm, param);
+    });
+  }
+
+  /// \note Only implemented for scalar functions, see GradientVisualizationAdapter.
+  template <size_t r, class R>
+  ThisType& add_gradient(const GridFunctionInterface<ElementType, r, 1, R>& function,
+                         const VisualizerInterface<d, 1, R>& visualizer,
+                         const std::string nm = "",
+                         const XT::Common::Parameter& param = {})
+  {
+    return add_field(true, [&function, &visualizer, nm, param]() -> std::unique_ptr<AdapterType> {
+      return std::make_unique<GradientVisualizationAdapter<GridViewType, r, 1, R>>(function, visualizer, nm, param);
+    });
+  }
+
+  /// \note Only implemented for scalar functions, see GradientVisualizationAdapter.
+  template <size_t r, class R>
+  ThisType& add_gradient(const GridFunctionInterface<ElementType, r, 1, R>& function,
+                         const std::string nm = "",
+                         const XT::Common::Parameter& param = {})
+  {
+    return add_field(true, [&function, nm, param]() -> std::unique_ptr<AdapterType> {
+      return std::make_unique<GradientVisualizationAdapter<GridViewType, r, 1, R>>(function, nm, param);
+    });
+  }
+
+  /**
+   * \name ``These methods add a grid function, a function (see FunctionInterface::as_grid_function) or a gradient of
+   *        either (see gradient_of()) with default name and visualizer, as used by visualize(grid_view, path, ...).''
+   * \{
+   */
+
+  template <class FunctionType>
+  std::enable_if_t<is_grid_function<FunctionType>::value, ThisType&> add(const FunctionType& function)
+  {
+    return add_function(function);
+  }
+
+  template <class FunctionType>
+  std::enable_if_t<is_function<FunctionType>::value, ThisType&> add(const FunctionType& function)
+  {
+    return add_function(function.template as_grid_function<ElementType>());
+  }
+
+  template <class FunctionType>
+  std::enable_if_t<is_grid_function<FunctionType>::value, ThisType&>
+  add(const VisualizedGradient<FunctionType>& gradient)
+  {
+    return add_gradient(gradient.function, gradient.name);
+  }
+
+  template <class FunctionType>
+  std::enable_if_t<is_function<FunctionType>::value, ThisType&>
+  add(const VisualizedGradient<FunctionType>& gradient)
+  {
+    return add_gradient(gradient.function.template as_grid_function<ElementType>(), gradient.name);
+  }
+
+  /// \}
+
+  /**
+   * \brief Writes path.vtu (if the grid view is not distributed), or path.pvtu and a piece path-p{rank}.vtu for each
+   *        rank (which contains the interior elements of this rank).
+   */
+  void write(const std::string& path) const
+  {
+    if (path.empty())
+      DUNE_THROW(Exceptions::wrong_input_given, "path must not be empty!");
+    Common::test_create_directory(Common::directory_only(path));
+    const auto& comm = grid_view_.comm();
+    if (comm.size() == 1) {
+      write_piece(path + ".vtu");
+      return;
+    }
+    write_piece(path + "-p" + Common::to_string(comm.rank()) + ".vtu");
+    comm.barrier();
+    if (comm.rank() == 0)
+      write_collection(path, comm.size());
+  } // ... write(...)
+
+private:
+  ThisType& add_field(const bool is_cell_data, std::function<std::unique_ptr<AdapterType>()> create_adapter)
+  {
+    const auto adapter = create_adapter();
+    fields_.push_back(Field{adapter->name(), adapter->ncomps(), is_cell_data, std::move(create_adapter)});
+    return *this;
+  }
+
+  static std::string byte_order()
+  {
+    const uint16_t one = 1;
+    return (*reinterpret_cast<const uint8_t*>(&one) == 1) ? "LittleEndian" : "BigEndian";
+  }
+
+  void write_collection(const std::string& path, const int num_pieces) const
+  {
+    std::ofstream file(path + ".pvtu");
+    if (!file.is_open())
+      DUNE_THROW(Dune::IOError, "could not open '" << path << ".pvtu' for writing!");
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"" << byte_order()
+         << "\" header_type=\"UInt64\">\n"
+         << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+    for (const bool cell_data : {false, true}) {
+      file << (cell_data ? "    <PCellData>\n" : "    <PPointData>\n");
+      for (const auto& field : fields_)
+        if (field.is_cell_data == cell_data)
+          file << "      <PDataArray type=\"Float32\" Name=\"" << field.name << "\" NumberOfComponents=\""
+               << field.ncomps << "\"/>\n";
+      file << (cell_data ? "    </PCellData>\n" : "    </PPointData>\n");
+    }
+    file << "    <PPoints>\n"
+         << "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n"
+         << "    </PPoints>\n";
+    const auto filename = Common::filename_only(path);
+    for (int pp = 0; pp < num_pieces; ++pp)
+      file << "    <Piece Source=\"" << filename << "-p" << pp << ".vtu\"/>\n";
+    file << "  </PUnstructuredGrid>\n"
+         << "</VTKFile>\n";
+    if (!file)
+      DUNE_THROW(Dune::IOError, "could not write '" << path << ".pvtu'!");
+  } // ... write_collection(...)
+
+  void write_piece(const std::string& filename) const
+  {
+    // count the cells and points
+    size_t num_cells = 0;
+    size_t num_points = 0;
+    for (auto&& element : elements(grid_view_, Partitions::interior)) {
+      ++num_cells;
+      num_points += element.geometry().corners();
+    }
+    // compute the layout of the appended data: point data, cell data, points, connectivity, offsets, types
+    std::vector<Array> arrays;
+    size_t offset = 0;
+    const auto add_array = [&](const size_t entry_size, const size_t num_entries) {
+      arrays.push_back(Array{offset, entry_size});
+      offset += sizeof(uint64_t) + entry_size * num_entries;
+      return arrays.back().offset;
+    };
+    std::stringstream header;
+    header << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << byte_order()
+           << "\" header_type=\"UInt64\">\n"
+           << "  <UnstructuredGrid>\n"
+           << "    <Piece NumberOfPoints=\"" << num_points << "\" NumberOfCells=\"" << num_cells << "\">\n";
+    for (const bool cell_data : {false, true}) {
+      header << (cell_data ? "      <CellData>\n" : "      <PointData>\n");
+      for (const auto& field : fields_)
+        if (field.is_cell_data == cell_data)
+          header << "        <DataArray type=\"Float32\" Name=\"" << field.name << "\" NumberOfComponents=\""
+                 << field.ncomps << "\" format=\"appended\" offset=\""
+                 << add_array(sizeof(float) * field.ncomps, cell_data ? num_cells : num_points) << "\"/>\n";
+      header << (cell_data ? "      </CellData>\n" : "      </PointData>\n");
+    }
+    // the arrays of the fields are stored in the order of fields_
+    std::vector<Array> field_arrays(fields_.size());
+    for (size_t ff = 0, pd = 0, cd = 0; ff < fields_.size(); ++ff)
+      field_arrays[ff] = fields_[ff].is_cell_data ? arrays[num_point_fields() + cd++] : arrays[pd++];
+    header << "      <Points>\n"
+           << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+           << add_array(3 * sizeof(float), num_points) << "\"/>\n"
+           << "      </Points>\n"
+           << "      <Cells>\n"
+           << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\""
+           << add_array(sizeof(int64_t), num_points) << "\"/>\n"
+           << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\""
+           << add_array(sizeof(int64_t), num_cells) << "\"/>\n"
+           << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\""
+           << add_array(sizeof(uint8_t), num_cells) << "\"/>\n"
+           << "      </Cells>\n"
+           << "    </Piece>\n"
+           << "  </UnstructuredGrid>\n"
+           << "  <AppendedData encoding=\"raw\">\n"
+           << "_";
+    const auto& points_array = arrays[arrays.size() - 4];
+    const auto& connectivity_array = arrays[arrays.size() - 3];
+    const auto& offsets_array = arrays[arrays.size() - 2];
+    const auto& types_array = arrays[arrays.size() - 1];
+    // write the header, the size of each array and the footer
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      DUNE_THROW(Dune::IOError, "could not open '" << filename << "' for writing!");
+    const std::string header_string = header.str();
+    const size_t appended_data_start = header_string.size();
+    file.write(header_string.data(), header_string.size());
+    for (size_t aa = 0; aa < arrays.size(); ++aa) {
+      const uint64_t array_size = ((aa + 1 < arrays.size()) ? arrays[aa + 1].offset : offset) - arrays[aa].offset
+                                  - sizeof(uint64_t);
+      file.seekp(appended_data_start + arrays[aa].offset);
+      file.write(reinterpret_cast<const char*>(&array_size), sizeof(uint64_t));
+    }
+    file.seekp(appended_data_start + offset);
+    file << "\n  </AppendedData>\n"
+         << "</VTKFile>\n";
+    // create an adapter for each field and thread
+    std::vector<std::vector<std::unique_ptr<AdapterType>>> adapters(num_threads_);
+    for (auto& thread_adapters : adapters)
+      for (const auto& field : fields_)
+        thread_adapters.emplace_back(field.create_adapter());
+    // process the elements chunkwise
+    std::vector<ElementType> chunk;
+    chunk.reserve(chunk_size_ * num_threads_);
+    std::vector<size_t> first_point_of_element; // w.r.t. the chunk
+    first_point_of_element.reserve(chunk_size_ * num_threads_ + 1);
+    first_point_of_element.push_back(0);
+    std::vector<std::vector<float>> field_values(fields_.size());
+    std::vector<float> points;
+    std::vector<int64_t> connectivity;
+    std::vector<int64_t> offsets;
+    std::vector<uint8_t> types;
+    size_t first_cell_of_chunk = 0;
+    size_t first_point_of_chunk = 0;
+    const auto write_entries =
+        [&](const Array& array, const size_t first_entry, const void* data, const size_t num_entries) {
+          file.seekp(appended_data_start + array.offset + sizeof(uint64_t) + first_entry * array.entry_size);
+          file.write(static_cast<const char*>(data), num_entries * array.entry_size);
+        };
+    const auto process_chunk = [&]() {
+      const size_t chunk_cells = chunk.size();
+      const size_t chunk_points = first_point_of_element[chunk_cells];
+      for (size_t ff = 0; ff < fields_.size(); ++ff)
+        field_values[ff].resize((fields_[ff].is_cell_data ? chunk_cells : chunk_points) * fields_[ff].ncomps);
+      points.resize(3 * chunk_points);
+      connectivity.resize(chunk_points);
+      offsets.resize(chunk_cells);
+      types.resize(chunk_cells);
+      // evaluate in parallel, each thread fills the entries of its elements
+      const auto process_elements = [&](const size_t thread, const size_t begin, const size_t end) {
+        auto& thread_adapters = adapters[thread];
+        for (size_t ee = begin; ee < end; ++ee) {
+          const auto& element = chunk[ee];
+          const auto geometry = element.geometry();
+          const auto& reference_element = ReferenceElements<D, d>::general(element.type());
+          const auto vtk_type = VTK::geometryType(element.type());
+          const size_t first_point = first_point_of_element[ee];
+          const int num_corners = geometry.corners();
+          for (int cc = 0; cc < num_corners; ++cc) {
+            const auto corner = geometry.corner(cc);
+            for (size_t dd = 0; dd < 3; ++dd)
+              points[3 * (first_point + cc) + dd] = (dd < corner.size()) ? static_cast<float>(corner[dd]) : 0.f;
+            connectivity[first_point + cc] =
+                static_cast<int64_t>(first_point_of_chunk + first_point + VTK::renumber(vtk_type, cc));
+          }
+          offsets[ee] = static_cast<int64_t>(first_point_of_chunk + first_point + num_corners);
+          types[ee] = static_cast<uint8_t>(vtk_type);
+          for (size_t ff = 0; ff < fields_.size(); ++ff) {
+            const auto& adapter = *thread_adapters[ff];
+            const auto& field = fields_[ff];
+            auto& values = field_values[ff];
+            if (field.is_cell_data) {
+              const auto center = reference_element.position(0, 0);
+              for (int comp = 0; comp < field.ncomps; ++comp)
+                values[ee * field.ncomps + comp] = static_cast<float>(adapter.evaluate(comp, element, center));
+            } else {
+              for (int cc = 0; cc < num_corners; ++cc) {
+                const auto corner = reference_element.position(cc, d);
+                for (int comp = 0; comp < field.ncomps; ++comp)
+                  values[(first_point + cc) * field.ncomps + comp] =
+                      static_cast<float>(adapter.evaluate(comp, element, corner));
+              }
+            }
+          }
+        }
+      }; // ... process_elements(...)
+      std::vector<std::thread> threads;
+      std::vector<std::exception_ptr> exceptions(num_threads_);
+      for (size_t tt = 0; tt < num_threads_; ++tt) {
+        const size_t begin = (tt * chunk_cells) / num_threads_;
+        const size_t end = ((tt + 1) * chunk_cells) / num_threads_;
+        const auto work = [&, tt, begin, end]() {
+          try {
+            process_elements(tt, begin, end);
+          } catch (...) {
+            exceptions[tt] = std::current_exception();
+          }
+        };
+        if (tt + 1 < num_threads_)
+          threads.emplace_back(work);
+        else
+          work();
+      }
+      for (auto& thread : threads)
+        thread.join();
+      for (const auto& exception : exceptions)
+        if (exception)
+          std::rethrow_exception(exception);
+      // write the chunk to its position in the file
+      for (size_t ff = 0; ff < fields_.size(); ++ff)
+        write_entries(field_arrays[ff],
+                      fields_[ff].is_cell_data ? first_cell_of_chunk : first_point_of_chunk,
+                      field_values[ff].data(),
+                      fields_[ff].is_cell_data ? chunk_cells : chunk_points);
+      write_entries(points_array, first_point_of_chunk, points.data(), chunk_points);
+      write_entries(connectivity_array, first_point_of_chunk, connectivity.data(), chunk_points);
+      write_entries(offsets_array, first_cell_of_chunk, offsets.data(), chunk_cells);
+      write_entries(types_array, first_cell_of_chunk, types.data(), chunk_cells);
+      first_cell_of_chunk += chunk_cells;
+      first_point_of_chunk += chunk_points;
+      chunk.clear();
+      first_point_of_element.resize(1);
+    }; // ... process_chunk(...)
+    for (auto&& element : elements(grid_view_, Partitions::interior)) {
+      chunk.emplace_back(element);
+      first_point_of_element.push_back(first_point_of_element.back() + element.geometry().corners());
+      if (chunk.size() == chunk_size_ * num_threads_)
+        process_chunk();
+    }
+    if (!chunk.empty())
+      process_chunk();
+    file.close();
+    if (!file)
+      DUNE_THROW(Dune::IOError, "could not write '" << filename << "'!");
+  } // ... write_piece(...)
+
+  size_t num_point_fields() const
+  {
+    return std::count_if(fields_.begin(), fields_.end(), [](const Field& field) { return !field.is_cell_data; });
+  }
+
+  const GridViewType grid_view_;
+  const size_t num_threads_;
+  const size_t chunk_size_;
+  std::vector<Field> fields_;
+}; // class ParallelVTUWriter
+
+
+/**
+ * \brief Visualizes several functions (any mix of grid functions, functions and gradients of either) in a single file
+ *        using a single pass over the grid, binding each local function once per element, see ParallelVTUWriter.
+ *
+ *        Usage:
+\code
+visualize(grid_view, "solution", pressure, gradient_of(pressure), velocity, permeability);
+\endcode
+ */
+template <class GridViewType, class... FunctionTypes>
+std::enable_if_t<XT::Grid::is_view<GridViewType>::value, void>
+visualize(const GridViewType& grid_view, const std::string path, const FunctionTypes&... functions)
+{
+  ParallelVTUWriter<GridViewType> writer(grid_view);
+  (void)std::initializer_list<int>{(writer.add(functions), 0)...};
+  writer.write(path);
+}
+
+
 } // namespace Functions
 } // namespace XT
 } // namespace Dune
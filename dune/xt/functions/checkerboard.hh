@@ -14,8 +14,14 @@
 #ifndef DUNE_XT_FUNCTIONS_CHECKERBOARD_HH
 #define DUNE_XT_FUNCTIONS_CHECKERBOARD_HH
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
 #include <dune/xt/common/configuration.hh>
 
+#include <dune/xt/functions/base/element-lookup.hh>
 #include <dune/xt/functions/interfaces/grid-function.hh>
 
 namespace Dune {
@@ -25,16 +31,202 @@ namespace Functions {
 
 /**
  * Note: This function does not allow for functions on the subdomains anymore. Only constant values are possible.
+ *
+ * The subdomain an element belongs to is determined on each bind of a local function, unless it has been precomputed
+ * for a grid view containing the element, see precompute_subdomains().
+ *
+ * The values are held by a ValuesInterface, which is shared between copies of the function. Apart from DenseValues,
+ * which stores one RangeType per subdomain, DiagonalValues allows to store only the diagonal of matrix-valued values
+ * (possibly in a different precision), which is expanded to a RangeType on binding a local function. ContiguousValues
+ * reads the values from contiguous memory, which may also be managed elsewhere (e.g. a numpy array).
  */
 template <class E, size_t r = 1, size_t rC = 1, class R = double>
-class CheckerboardFunction : public GridFunctionInterface<E, r, rC, R>
+class CheckerboardFunction : public StaticGridFunctionInterface<CheckerboardFunction<E, r, rC, R>, E, r, rC, R>
 {
-  using BaseType = GridFunctionInterface<E, r, rC, R>;
+  using BaseType = StaticGridFunctionInterface<CheckerboardFunction<E, r, rC, R>, E, r, rC, R>;
   using ThisType = CheckerboardFunction<E, r, rC, R>;
   using BaseType::domain_dim;
   static_assert(domain_dim <= 3, "Not implemented for domain_dim > 3 (see find_subdomain method)!");
 
-  class LocalCheckerboardFunction : public ElementFunctionInterface<E, r, rC, R>
+  using DomainType_ = typename BaseType::LocalFunctionType::DomainType;
+  using RangeType_ = typename BaseType::LocalFunctionType::RangeType;
+
+  /// marks elements outside of the checkerboard in the precomputed subdomains
+  static const constexpr uint32_t outside_ = std::numeric_limits<uint32_t>::max();
+
+  using SubdomainLookupsType = internal::ElementLookups<E, uint32_t>;
+
+public:
+  class ValuesInterface
+  {
+  public:
+    virtual ~ValuesInterface() = default;
+
+    /// \return the number of subdomains values are stored for
+    virtual size_t size() const = 0;
+
+    virtual RangeType_ get(const size_t subdomain) const = 0;
+  }; // class ValuesInterface
+
+  class DenseValues : public ValuesInterface
+  {
+  public:
+    DenseValues(std::vector<RangeType_> values)
+      : values_(std::move(values))
+    {}
+
+    size_t size() const override final
+    {
+      return values_.size();
+    }
+
+    RangeType_ get(const size_t subdomain) const override final
+    {
+      return values_[subdomain];
+    }
+
+  private:
+    const std::vector<RangeType_> values_;
+  }; // class DenseValues
+
+  /**
+   * \brief Stores only the r diagonal entries of each value (as F), for r == rC.
+   *
+   *        The entries of subdomain ss are given by diagonal_entries[ss * r], ..., diagonal_entries[ss * r + r - 1].
+   */
+  template <class F = R>
+  class DiagonalValues : public ValuesInterface
+  {
+    static_assert(r == rC, "Only available for square matrices!");
+
+    template <size_t rC_ = rC, bool anything = true>
+    struct expand
+    {
+      static void diagonal(const F* entries, RangeType_& value)
+      {
+        for (size_t rr = 0; rr < r; ++rr)
+          value[rr][rr] = entries[rr];
+      }
+    };
+
+    template <bool anything>
+    struct expand<1, anything>
+    {
+      static void diagonal(const F* entries, RangeType_& value)
+      {
+        value[0] = entries[0];
+      }
+    };
+
+  public:
+    DiagonalValues(std::vector<F> diagonal_entries)
+      : diagonal_entries_(std::move(diagonal_entries))
+    {
+      DUNE_THROW_IF(diagonal_entries_.size() % r != 0,
+                    Common::Exceptions::shapes_do_not_match,
+                    "The number of diagonal entries (" << diagonal_entries_.size() << ") has to be a multiple of " << r
+                                                       << "!");
+    }
+
+    size_t size() const override final
+    {
+      return diagonal_entries_.size() / r;
+    }
+
+    RangeType_ get(const size_t subdomain) const override final
+    {
+      RangeType_ value(0);
+      expand<>::diagonal(diagonal_entries_.data() + subdomain * r, value);
+      return value;
+    }
+
+  private:
+    const std::vector<F> diagonal_entries_;
+  }; // class DiagonalValues
+
+  /**
+   * \brief Reads the values from contiguous memory, which is either owned or referenced.
+   *
+   *        The entries of subdomain ss are given by entries[ss * r * rC], ..., entries[(ss + 1) * r * rC - 1] (row-wise
+   *        for matrices). If the memory is only referenced, storage has to keep it alive (and is held by all copies of
+   *        these values), which allows to use memory managed elsewhere (e.g. by numpy) without copying it.
+   */
+  class ContiguousValues : public ValuesInterface
+  {
+    template <size_t rC_ = rC, bool anything = true>
+    struct assign
+    {
+      static void entries(const R* entries, RangeType_& value)
+      {
+        for (size_t rr = 0; rr < r; ++rr)
+          for (size_t cc = 0; cc < rC; ++cc)
+            value[rr][cc] = entries[rr * rC + cc];
+      }
+    };
+
+    template <bool anything>
+    struct assign<1, anything>
+    {
+      static void entries(const R* entries, RangeType_& value)
+      {
+        for (size_t rr = 0; rr < r; ++rr)
+          value[rr] = entries[rr];
+      }
+    };
+
+  public:
+    ContiguousValues(std::vector<R> entries)
+      : owned_entries_(std::make_shared<const std::vector<R>>(std::move(entries)))
+      , entries_(owned_entries_->data())
+      , num_entries_(owned_entries_->size())
+      , storage_(owned_entries_)
+    {
+      check_num_entries();
+    }
+
+    ContiguousValues(const R* entries, const size_t num_entries, std::shared_ptr<const void> storage)
+      : entries_(entries)
+      , num_entries_(num_entries)
+      , storage_(std::move(storage))
+    {
+      DUNE_THROW_IF(entries_ == nullptr && num_entries_ > 0, Common::Exceptions::wrong_input_given, "entries is null!");
+      check_num_entries();
+    }
+
+    size_t size() const override final
+    {
+      return num_entries_ / (r * rC);
+    }
+
+    RangeType_ get(const size_t subdomain) const override final
+    {
+      RangeType_ value;
+      assign<>::entries(entries_ + subdomain * r * rC, value);
+      return value;
+    }
+
+    /// the entries of all subdomains, see above
+    const R* data() const
+    {
+      return entries_;
+    }
+
+  private:
+    void check_num_entries() const
+    {
+      DUNE_THROW_IF(num_entries_ % (r * rC) != 0,
+                    Common::Exceptions::shapes_do_not_match,
+                    "The number of entries (" << num_entries_ << ") has to be a multiple of " << r * rC << "!");
+    }
+
+    const std::shared_ptr<const std::vector<R>> owned_entries_;
+    const R* entries_;
+    const size_t num_entries_;
+    const std::shared_ptr<const void> storage_;
+  }; // class ContiguousValues
+
+private:
+  class LocalCheckerboardFunction final : public ElementFunctionInterface<E, r, rC, R>
   {
     using InterfaceType = ElementFunctionInterface<E, r, rC, R>;
 
@@ -50,23 +242,30 @@ class CheckerboardFunction : public GridFunctionInterface<E, r, rC, R>
     LocalCheckerboardFunction(const DomainType& lower_left,
                               const DomainType& upper_right,
                               const FieldVector<size_t, domain_dim>& num_elements,
-                              std::vector<RangeType>& values)
+                              const std::shared_ptr<const ValuesInterface>& values,
+                              const SubdomainLookupsType& subdomain_lookups)
       : InterfaceType()
       , lower_left_(lower_left)
       , upper_right_(upper_right)
       , num_elements_(num_elements)
       , values_(values)
+      , subdomain_lookups_(subdomain_lookups)
     {}
 
   protected:
     void post_bind(const ElementType& element) override final
     {
       current_value_ = 0;
-      if (is_in_checkerboard(element)) {
-        const size_t subdomain = find_subdomain(element);
-        current_value_ = values_[subdomain];
+      uint32_t subdomain = outside_;
+      if (subdomain_lookups_.lookup(element, subdomain)) {
+        if (subdomain != outside_)
+          current_value_ = values_->get(subdomain);
+        return;
       }
-    }
+      const auto center = element.geometry().center();
+      if (is_in_checkerboard(center, lower_left_, upper_right_))
+        current_value_ = values_->get(find_subdomain(center, lower_left_, upper_right_, num_elements_));
+    } // ... post_bind(...)
 
   public:
     int order(const Common::Parameter& /*param*/ = {}) const override final
@@ -89,50 +288,18 @@ class CheckerboardFunction : public GridFunctionInterface<E, r, rC, R>
     }
 
   private:
-    bool is_in_checkerboard(const ElementType& element) const
-    {
-      const auto center = element.geometry().center();
-      if (Common::FloatCmp::le(lower_left_, center) && Common::FloatCmp::lt(center, upper_right_))
-        return 1;
-      else
-        return 0;
-    }
-
-    size_t find_subdomain(const ElementType& element) const
-    {
-      // decide to which subdomain the center of the element belongs to
-      const auto center = element.geometry().center();
-      std::vector<size_t> which_partition(domain_dim, 0);
-      const auto& ll = lower_left_;
-      const auto& ur = upper_right_;
-      const auto& ne = num_elements_;
-      for (size_t dd = 0; dd < domain_dim; ++dd) {
-        // for points that are on upper_right_[d], this selects one partition too much
-        // so we need to cap this
-        which_partition[dd] =
-            std::min(size_t(std::floor(ne[dd] * ((center[dd] - ll[dd]) / (ur[dd] - ll[dd])))), ne[dd] - 1);
-      }
-      size_t subdomain = 0;
-      if (domain_dim == 1)
-        subdomain = which_partition[0];
-      else if (domain_dim == 2)
-        subdomain = which_partition[0] + which_partition[1] * ne[0];
-      else
-        subdomain = which_partition[0] + which_partition[1] * ne[0] + which_partition[2] * ne[1] * ne[0];
-      return subdomain;
-    } // ... find_subdomain(...)
-
-
     const DomainType lower_left_;
     const DomainType upper_right_;
     const FieldVector<size_t, domain_dim> num_elements_;
-    const std::vector<RangeType>& values_;
+    const std::shared_ptr<const ValuesInterface> values_;
+    const SubdomainLookupsType subdomain_lookups_;
     RangeType current_value_;
   }; // class LocalCheckerboardFunction
 
 public:
   using typename BaseType::ElementType;
   using typename BaseType::LocalFunctionType;
+  using StaticLocalFunctionType = LocalCheckerboardFunction;
 
   using RangeType = typename LocalFunctionType::RangeType;
   using DomainType = typename LocalFunctionType::DomainType;
@@ -160,12 +327,21 @@ public:
                        const FieldVector<size_t, domain_dim>& num_elements,
                        const std::vector<RangeType>& values,
                        const std::string nm = "checkerboard")
+    : CheckerboardFunction(lower_left, upper_right, num_elements, std::make_shared<const DenseValues>(values), nm)
+  {}
+
+  CheckerboardFunction(const DomainType& lower_left,
+                       const DomainType& upper_right,
+                       const FieldVector<size_t, domain_dim>& num_elements,
+                       std::shared_ptr<const ValuesInterface> values,
+                       const std::string nm = "checkerboard")
     : lower_left_(lower_left)
     , upper_right_(upper_right)
     , num_elements_(num_elements)
-    , values_(new std::vector<RangeType>(values))
+    , values_(std::move(values))
     , name_(nm)
   {
+    DUNE_THROW_IF(!values_, Common::Exceptions::wrong_input_given, "values must not be empty!");
 #ifndef NDEBUG
     // checks
     size_t total_subdomains = 1;
@@ -194,14 +370,47 @@ public:
     return name_;
   }
 
-  std::unique_ptr<LocalFunctionType> local_function() const override final
+  std::unique_ptr<StaticLocalFunctionType> static_local_function() const
+  {
+    return std::make_unique<LocalCheckerboardFunction>(
+        lower_left_, upper_right_, num_elements_, values_, subdomain_lookups_);
+  }
+
+  /**
+   * \brief Determines the subdomain of each element of grid_view once, so that binding a local function to one of
+   *        these elements amounts to a single lookup (for elements not contained in any grid view passed here, the
+   *        subdomain is still computed on each bind).
+   *
+   * \note Only affects local functions obtained afterwards, and has to be called again if the grid changes (which
+   *       replaces the subdomains precomputed for grid_view before).
+   */
+  template <class GV>
+  std::enable_if_t<Grid::is_view<GV>::value && std::is_same<XT::Grid::extract_entity_t<GV>, E>::value, void>
+  precompute_subdomains(const GV& grid_view)
+  {
+    const size_t total_subdomains = values_->size();
+    if (total_subdomains >= outside_)
+      DUNE_THROW(Common::Exceptions::wrong_input_given,
+                 "Too many subdomains to be precomputed (" << total_subdomains << ")!");
+    subdomain_lookups_.precompute(grid_view, uint32_t(outside_), [&](const auto& element, uint32_t& subdomain) {
+      const auto center = element.geometry().center();
+      if (is_in_checkerboard(center, lower_left_, upper_right_))
+        subdomain = static_cast<uint32_t>(find_subdomain(center, lower_left_, upper_right_, num_elements_));
+    });
+  }
+
+  /// \note Only affects local functions obtained afterwards.
+  void clear_precomputed_subdomains()
   {
-    return std::make_unique<LocalCheckerboardFunction>(lower_left_, upper_right_, num_elements_, *values_);
+    subdomain_lookups_.clear();
   }
 
   size_t subdomain(const ElementType& element) const
   {
-    return find_subdomain(element);
+    uint32_t subdomain = outside_;
+    if (subdomain_lookups_.lookup(element, subdomain) && subdomain != outside_)
+      return subdomain;
+    return find_subdomain(element.geometry().center(), lower_left_, upper_right_, num_elements_);
   }
 
   size_t subdomains() const
@@ -209,20 +418,24 @@ public:
     return values_->size();
   }
 
-  const std::vector<std::shared_ptr<const RangeType>>& values() const
+  const ValuesInterface& values() const
   {
-    return values_;
+    return *values_;
   }
 
 private:
-  size_t find_subdomain(const ElementType& element) const
+  static bool is_in_checkerboard(const DomainType& center, const DomainType& ll, const DomainType& ur)
+  {
+    return Common::FloatCmp::le(ll, center) && Common::FloatCmp::lt(center, ur);
+  }
+
+  static size_t find_subdomain(const DomainType& center,
+                               const DomainType& ll,
+                               const DomainType& ur,
+                               const FieldVector<size_t, domain_dim>& ne)
   {
     // decide on the subdomain the center of the element belongs to
-    const auto center = element.geometry().center();
-    std::vector<size_t> which_partition(domain_dim, 0);
-    const auto& ll = lower_left_;
-    const auto& ur = upper_right_;
-    const auto& ne = num_elements_;
+    FieldVector<size_t, domain_dim> which_partition(0);
     for (size_t dd = 0; dd < domain_dim; ++dd) {
       // for points that are on upper_right_[d], this selects one partition too much
       // so we need to cap this
@@ -242,8 +455,9 @@ private:
   const DomainType lower_left_;
   const DomainType upper_right_;
   const FieldVector<size_t, domain_dim> num_elements_;
-  std::shared_ptr<std::vector<RangeType>> values_;
+  std::shared_ptr<const ValuesInterface> values_;
   std::string name_;
+  SubdomainLookupsType subdomain_lookups_;
 }; // class CheckerboardFunction
 
 
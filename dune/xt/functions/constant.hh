@@ -93,17 +93,63 @@ public:
 
 
 template <class Element, size_t rangeDim = 1, size_t rangeDimCols = 1, class RangeField = double>
-class ConstantGridFunction : public GridFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>
+class ConstantGridFunction
+  : public StaticGridFunctionInterface<ConstantGridFunction<Element, rangeDim, rangeDimCols, RangeField>,
+                                       Element,
+                                       rangeDim,
+                                       rangeDimCols,
+                                       RangeField>
 {
-  using BaseType = GridFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>;
+  using BaseType = StaticGridFunctionInterface<ConstantGridFunction<Element, rangeDim, rangeDimCols, RangeField>,
+                                               Element,
+                                               rangeDim,
+                                               rangeDimCols,
+                                               RangeField>;
+
+  class LocalConstantGridFunction final : public ElementFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>
+  {
+    using InterfaceType = ElementFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>;
+
+  public:
+    using typename InterfaceType::DerivativeRangeReturnType;
+    using typename InterfaceType::DomainType;
+    using typename InterfaceType::RangeReturnType;
+
+    LocalConstantGridFunction(const RangeReturnType& value)
+      : InterfaceType()
+      , value_(value)
+    {}
+
+    int order(const Common::Parameter& /*param*/ = {}) const override final
+    {
+      return 0;
+    }
+
+    RangeReturnType evaluate(const DomainType& point_in_reference_element,
+                             const Common::Parameter& /*param*/ = {}) const override final
+    {
+      this->assert_inside_reference_element(point_in_reference_element);
+      return value_;
+    }
+
+    DerivativeRangeReturnType jacobian(const DomainType& point_in_reference_element,
+                                       const Common::Parameter& /*param*/ = {}) const override final
+    {
+      this->assert_inside_reference_element(point_in_reference_element);
+      return DerivativeRangeReturnType(); // defaults to 0
+    }
+
+  private:
+    const RangeReturnType value_;
+  }; // class LocalConstantGridFunction
 
 public:
   using typename BaseType::LocalFunctionType;
+  using StaticLocalFunctionType = LocalConstantGridFunction;
 
   ConstantGridFunction(const typename LocalFunctionType::RangeReturnType constant,
                        const std::string name_in = static_id())
     : constant_function_(constant, name_in)
-    , constant_grid_function_(constant_function_)
   {}
 
   static std::string static_id()
@@ -111,9 +157,9 @@ public:
     return "dune.xt.functions.constantgridfunction";
   }
 
-  virtual std::unique_ptr<LocalFunctionType> local_function() const override final
+  std::unique_ptr<StaticLocalFunctionType> static_local_function() const
   {
-    return constant_grid_function_.local_function();
+    return std::make_unique<LocalConstantGridFunction>(constant_function_.value_);
   }
 
   virtual std::string name() const override final
@@ -123,7 +169,6 @@ public:
 
 private:
   ConstantFunction<BaseType::domain_dim, rangeDim, rangeDimCols, RangeField> constant_function_;
-  FunctionAsGridFunctionWrapper<Element, rangeDim, rangeDimCols, RangeField> constant_grid_function_;
 }; // class ConstantGridFunction
 
 
@@ -14,7 +14,7 @@
 #ifndef DUNE_XT_FUNCTIONS_EXPRESSION_BASE_HH
 #define DUNE_XT_FUNCTIONS_EXPRESSION_BASE_HH
 
-#include <mutex>
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -26,16 +26,41 @@
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/string.hh>
 
+#include "jit.hh"
 #include "mathexpr.hh"
 
 #ifndef DUNE_XT_FUNCTIONS_EXPRESSION_BASE_MAX_DYNAMIC_SIZE
 #  define DUNE_XT_FUNCTIONS_EXPRESSION_BASE_MAX_DYNAMIC_SIZE 64
 #endif
 
+#ifndef DUNE_XT_FUNCTIONS_EXPRESSION_BASE_BLOCK_SIZE
+#  define DUNE_XT_FUNCTIONS_EXPRESSION_BASE_BLOCK_SIZE 64
+#endif
+
+#ifndef DUNE_XT_FUNCTIONS_EXPRESSION_BASE_MAX_TEMPORARIES
+#  define DUNE_XT_FUNCTIONS_EXPRESSION_BASE_MAX_TEMPORARIES 64
+#endif
+
 
 namespace Dune {
 namespace XT {
 namespace Functions {
+namespace internal {
+
+
+/**
+ * \brief Per-thread scratch memory for the reentrant ROperation::Val, grows on demand and is never shrunk.
+ */
+inline double* math_expression_stack(const size_t size)
+{
+  thread_local std::vector<double> stack;
+  if (stack.size() < size)
+    stack.resize(size);
+  return stack.data();
+}
+
+
+} // namespace internal
 
 
 /**
@@ -57,34 +82,77 @@ public:
   using RangeFieldType = RangeField;
   static const size_t range_dim = rangeDim;
 
+  /// Maximal number of common subexpressions which are computed only once, see EliminateCommonSubexpressions.
+  static const size_t max_temporaries = DUNE_XT_FUNCTIONS_EXPRESSION_BASE_MAX_TEMPORARIES;
+
   //  MathExpressionBase(const std::string var, const std::string expr)
   //  {
   //    const std::vector<std::string> expressions(1, expr);
   //    setup(var, expressions);
   //  }
 
-  MathExpressionBase(const std::string& var, const Common::FieldVector<std::string, range_dim>& exprs)
+  /**
+   * \param backend "interpreter", "vectorized" (the interpreter, using vectorized kernels when evaluating several points
+   *                at once, see ROperation::VecVal) or "jit" (see internal::MathExpressionJit), falls back to the
+   *                interpreter if the expressions cannot be compiled to native code.
+   */
+  MathExpressionBase(const std::string& var,
+                     const Common::FieldVector<std::string, range_dim>& exprs,
+                     const std::string backend = "interpreter")
     : variable_(var)
     , expressions_(exprs)
+    , with_derivatives_(false)
+    , requested_backend_(backend)
   {
     setup();
   }
 
+  /**
+   * \brief Creates the given expressions together with all their first derivatives if with_derivatives is true, which
+   *        are obtained symbolically (see ROperation::Diff) and share their common subexpressions with the expressions.
+   *
+   *        In that case, range_dim has to be exprs.size() * (domain_dim + 1): the ii-th component is the ii-th
+   *        expression, component exprs.size() + ii * domain_dim + dd its derivative w.r.t. the dd-th variable.
+   */
+  MathExpressionBase(const std::string& var,
+                     const std::vector<std::string>& exprs,
+                     const bool with_derivatives,
+                     const std::string backend = "interpreter")
+    : variable_(var)
+    , with_derivatives_(with_derivatives)
+    , requested_backend_(backend)
+  {
+    const size_t num_expressions = with_derivatives_ ? range_dim / (domain_dim + 1) : range_dim;
+    if (exprs.size() != num_expressions || (with_derivatives_ && range_dim % (domain_dim + 1) != 0))
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "exprs.size(): " << exprs.size() << "\n   "
+                                  << "range_dim: " << range_dim << "\n   "
+                                  << "with_derivatives: " << with_derivatives);
+    for (size_t ii = 0; ii < num_expressions; ++ii)
+      expressions_[ii] = exprs[ii];
+    setup();
+  }
+
   MathExpressionBase(const ThisType& other)
+    : variable_(other.variable_)
+    , expressions_(other.expressions_)
+    , with_derivatives_(other.with_derivatives_)
+    , requested_backend_(other.requested_backend_)
   {
-    setup(other.variable(), other.expression());
+    setup();
   }
 
   ThisType& operator=(const ThisType& other)
   {
     if (this != &other) {
       cleanup();
-      variable_ = std::string("");
-      variables_ = Common::FieldVector<std::string, domain_dim>(std::string(""));
-      expressions_ = Common::FieldVector<std::string, range_dim>(std::string(""));
+      variable_ = other.variable_;
+      expressions_ = other.expressions_;
+      with_derivatives_ = other.with_derivatives_;
+      requested_backend_ = other.requested_backend_;
       setup();
     }
-    return this;
+    return *this;
   }
 
   ~MathExpressionBase()
@@ -102,16 +170,26 @@ public:
     return expressions_;
   }
 
+  /**
+   * \brief The backend which is actually used, "interpreter", "vectorized" or "jit".
+   */
+  std::string backend() const
+  {
+    if (jit_.evaluate != nullptr)
+      return "jit";
+    return vectorized_ ? "vectorized" : "interpreter";
+  }
+
+  /**
+   * \note All evaluate methods are reentrant and may be called concurrently from several threads.
+   */
   void evaluate(const Dune::FieldVector<DomainFieldType, domain_dim>& arg,
                 Dune::FieldVector<RangeFieldType, range_dim>& ret) const
   {
-    std::lock_guard<std::mutex> guard(mutex_);
-    // copy arg
-    for (typename Dune::FieldVector<DomainFieldType, domain_dim>::size_type ii = 0; ii < domain_dim; ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::FieldVector<RangeFieldType, range_dim>::size_type ii = 0; ii < range_dim; ++ii)
-      ret[ii] = op_[ii]->Val();
+    double args[domain_dim + max_temporaries];
+    for (size_t ii = 0; ii < domain_dim; ++ii)
+      args[ii] = arg[ii];
+    evaluate_args(args, ret);
   }
 
   /**
@@ -119,32 +197,25 @@ public:
    */
   void evaluate(const Dune::DynamicVector<DomainFieldType>& arg, Dune::DynamicVector<RangeFieldType>& ret) const
   {
-    std::lock_guard<std::mutex> guard(mutex_);
     // check for sizes
     assert(arg.size() > 0);
     if (ret.size() != range_dim)
       ret = Dune::DynamicVector<RangeFieldType>(range_dim);
-    // copy arg
-    for (size_t ii = 0; ii < std::min(domain_dim, arg.size()); ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::DynamicVector<RangeFieldType>::size_type ii = 0; ii < range_dim; ++ii)
-      ret[ii] = op_[ii]->Val();
+    double args[domain_dim + max_temporaries];
+    copy_args(arg, args);
+    evaluate_args(args, ret);
   }
 
   void evaluate(const Dune::FieldVector<DomainFieldType, domain_dim>& arg,
                 Dune::DynamicVector<RangeFieldType>& ret) const
   {
-    std::lock_guard<std::mutex> guard(mutex_);
     // check for sizes
     if (ret.size() != range_dim)
       ret = Dune::DynamicVector<RangeFieldType>(range_dim);
-    // copy arg
-    for (typename Dune::FieldVector<DomainFieldType, domain_dim>::size_type ii = 0; ii < domain_dim; ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::DynamicVector<RangeFieldType>::size_type ii = 0; ii < range_dim; ++ii)
-      ret[ii] = op_[ii]->Val();
+    double args[domain_dim + max_temporaries];
+    for (size_t ii = 0; ii < domain_dim; ++ii)
+      args[ii] = arg[ii];
+    evaluate_args(args, ret);
   }
 
   /**
@@ -153,16 +224,66 @@ public:
   void evaluate(const Dune::DynamicVector<DomainFieldType>& arg,
                 Dune::FieldVector<RangeFieldType, range_dim>& ret) const
   {
-    std::lock_guard<std::mutex> guard(mutex_);
     assert(arg.size() > 0);
-    // copy arg
-    for (size_t ii = 0; ii < std::min(domain_dim, arg.size()); ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (size_t ii = 0; ii < range_dim; ++ii)
-      ret[ii] = op_[ii]->Val();
+    double args[domain_dim + max_temporaries];
+    copy_args(arg, args);
+    evaluate_args(args, ret);
+  }
+
+  /**
+   * \brief Evaluates all points at once, see evaluate_blockwise.
+   * \attention ret will be resized!
+   */
+  void evaluate(const std::vector<Dune::FieldVector<DomainFieldType, domain_dim>>& points,
+                std::vector<Dune::FieldVector<RangeFieldType, range_dim>>& ret) const
+  {
+    ret.resize(points.size());
+    evaluate_blockwise(
+        points.size(),
+        [&](const size_t pp) -> const Dune::FieldVector<DomainFieldType, domain_dim>& { return points[pp]; },
+        [&](const size_t pp, const size_t ii, const double& value) { ret[pp][ii] = value; });
   }
 
+  /**
+   * \brief Evaluates num_points points at once.
+   *
+   *        The points are processed in blocks of DUNE_XT_FUNCTIONS_EXPRESSION_BASE_BLOCK_SIZE, which are transposed
+   *        into a structure of arrays, so that each instruction of the compiled expressions is applied to all points
+   *        of a block at once.
+   *
+   * \param point  point(pp) has to return the pp-th point (anything with operator[])
+   * \param set    set(pp, ii, value) is called with the value of the ii-th expression in the pp-th point
+   */
+  template <class PointAccessor, class ValueSetter>
+  void evaluate_blockwise(const size_t num_points, PointAccessor&& point, ValueSetter&& set) const
+  {
+    const size_t block_size = DUNE_XT_FUNCTIONS_EXPRESSION_BASE_BLOCK_SIZE;
+    const size_t num_args = domain_dim + num_temporaries_;
+    double* args = internal::math_expression_stack((num_args + range_dim + stack_size_) * block_size);
+    double* values = args + num_args * block_size;
+    double* stack = values + range_dim * block_size;
+    for (size_t first = 0; first < num_points; first += block_size) {
+      const size_t num = std::min(block_size, num_points - first);
+      for (size_t pp = 0; pp < num; ++pp) {
+        const auto& xx = point(first + pp);
+        for (size_t ii = 0; ii < domain_dim; ++ii)
+          args[ii * num + pp] = xx[ii];
+      }
+      if (jit_.evaluate_block != nullptr)
+        jit_.evaluate_block(int(num), args, values);
+      else {
+        // the temporaries are stored after the arguments
+        for (size_t kk = num_temporaries_; kk > 0; --kk)
+          evaluate_block(*temporary_[kk - 1], int(num), args, args + (domain_dim + kk - 1) * num, stack);
+        for (size_t ii = 0; ii < range_dim; ++ii)
+          evaluate_block(*op_[ii], int(num), args, values + ii * num, stack);
+      }
+      for (size_t ii = 0; ii < range_dim; ++ii)
+        for (size_t pp = 0; pp < num; ++pp)
+          set(first + pp, ii, values[ii * num + pp]);
+    }
+  } // ... evaluate_blockwise(...)
+
   void report(const std::string _name = "function.mathexpressionbase",
               std::ostream& stream = std::cout,
               const std::string& _prefix = "") const
@@ -186,17 +307,90 @@ private:
     // fill variables (i.e. "x[0]", "x[1]", ...)
     for (size_t ii = 0; ii < domain_dim; ++ii)
       variables_[ii] = variable_ + "[" + Common::to_string(ii) + "]";
-    // create expressions
+    // create expressions, the values stored in arg_ are never used, only their addresses identify the variables
+    for (size_t ii = 0; ii < domain_dim + max_temporaries; ++ii)
+      arg_[ii] = 0.;
     for (size_t ii = 0; ii < domain_dim; ++ii) {
-      arg_[ii] = new DomainFieldType(0.0);
-      var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_[ii]);
+      var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_ + ii);
       vararray_[ii] = var_arg_[ii];
     }
-    for (size_t ii = 0; ii < range_dim; ++ii) {
+    const size_t num_expressions = with_derivatives_ ? range_dim / (domain_dim + 1) : range_dim;
+    for (size_t ii = 0; ii < num_expressions; ++ii) {
       op_[ii] = new ROperation(expressions_[ii].c_str(), domain_dim, vararray_);
+      *op_[ii] = op_[ii]->Simplify();
+    }
+    if (with_derivatives_) {
+      for (size_t ii = 0; ii < num_expressions; ++ii) {
+        for (size_t dd = 0; dd < domain_dim; ++dd) {
+          const size_t jj = num_expressions + ii * domain_dim + dd;
+          op_[jj] = new ROperation(op_[ii]->Diff(*var_arg_[dd]).Simplify());
+          char* tmp = op_[jj]->Expr();
+          expressions_[jj] = tmp;
+          delete[] tmp;
+        }
+      }
     }
+    jit_ = {nullptr, nullptr};
+    vectorized_ = (requested_backend_ == "vectorized");
+    if (requested_backend_ == "jit")
+      setup_jit();
+    else if (requested_backend_ != "interpreter" && requested_backend_ != "vectorized")
+      DUNE_THROW(Common::Exceptions::wrong_input_given,
+                 "Unknown backend '" << requested_backend_ << "', has to be 'interpreter', 'vectorized' or 'jit'!");
+    // the compiler eliminates common subexpressions on its own, the interpreter computes them once per evaluation as
+    // additional variables (following the actual ones in arg_)
+    num_temporaries_ = 0;
+    if (jit_.evaluate == nullptr)
+      num_temporaries_ = EliminateCommonSubexpressions(
+          int(range_dim), op_, int(max_temporaries), arg_ + domain_dim, temporary_var_, temporary_);
+    stack_size_ = 0;
+    for (size_t ii = 0; ii < range_dim; ++ii)
+      stack_size_ = std::max(stack_size_, size_t(op_[ii]->StackSize()));
+    for (size_t kk = 0; kk < num_temporaries_; ++kk)
+      stack_size_ = std::max(stack_size_, size_t(temporary_[kk]->StackSize()));
   } // ... setup(...)
 
+  void setup_jit()
+  {
+    std::string code[range_dim];
+    for (size_t ii = 0; ii < range_dim; ++ii) {
+      char* tmp = op_[ii]->CCode(arg_, domain_dim);
+      if (tmp == nullptr)
+        return;
+      code[ii] = tmp;
+      delete[] tmp;
+    }
+    jit_ = internal::MathExpressionJit::compile(code, range_dim, domain_dim);
+  } // ... setup_jit(...)
+
+  /// args has to hold domain_dim + max_temporaries values, the first domain_dim of which are the arguments
+  template <class V>
+  void evaluate_args(double* args, V& ret) const
+  {
+    if (jit_.evaluate != nullptr) {
+      double values[range_dim];
+      jit_.evaluate(args, values);
+      for (size_t ii = 0; ii < range_dim; ++ii)
+        ret[ii] = values[ii];
+    } else {
+      const int num_args = int(domain_dim + num_temporaries_);
+      double* stack = internal::math_expression_stack(stack_size_);
+      for (size_t kk = num_temporaries_; kk > 0; --kk)
+        args[domain_dim + kk - 1] = temporary_[kk - 1]->Val(arg_, num_args, args, stack);
+      for (size_t ii = 0; ii < range_dim; ++ii)
+        ret[ii] = op_[ii]->Val(arg_, num_args, args, stack);
+    }
+  } // ... evaluate_args(...)
+
+  void evaluate_block(const ROperation& op, const int num, const double* args, double* values, double* stack) const
+  {
+    const int num_args = int(domain_dim + num_temporaries_);
+    if (vectorized_)
+      op.VecVal(arg_, num_args, num, args, values, stack);
+    else
+      op.Val(arg_, num_args, num, args, values, stack);
+  }
+
   void cleanup()
   {
     for (size_t ii = 0; ii < range_dim; ++ii) {
@@ -204,19 +398,38 @@ private:
     }
     for (size_t ii = 0; ii < domain_dim; ++ii) {
       delete var_arg_[ii];
-      delete arg_[ii];
+    }
+    for (size_t kk = 0; kk < num_temporaries_; ++kk) {
+      delete temporary_[kk];
+      delete temporary_var_[kk];
     }
   } // void cleanup()
 
+  static void copy_args(const Dune::DynamicVector<DomainFieldType>& arg, double* args)
+  {
+    const size_t size = std::min(domain_dim, arg.size());
+    for (size_t ii = 0; ii < size; ++ii)
+      args[ii] = arg[ii];
+    for (size_t ii = size; ii < domain_dim; ++ii)
+      args[ii] = 0.;
+  }
+
   std::string variable_;
   Common::FieldVector<std::string, domain_dim> variables_;
   Common::FieldVector<std::string, range_dim> expressions_;
+  bool with_derivatives_;
   size_t actualDimRange_;
-  mutable DomainFieldType* arg_[domain_dim];
+  double arg_[domain_dim + max_temporaries];
   RVar* var_arg_[domain_dim];
   RVar* vararray_[domain_dim];
   ROperation* op_[range_dim];
-  mutable std::mutex mutex_;
+  RVar* temporary_var_[max_temporaries];
+  ROperation* temporary_[max_temporaries];
+  size_t num_temporaries_;
+  size_t stack_size_;
+  std::string requested_backend_;
+  bool vectorized_;
+  internal::MathExpressionJit::CompiledType jit_;
 }; // class MathExpressionBase
 
 
@@ -255,7 +468,7 @@ public:
       expressions_ = std::vector<std::string>();
       setup(other.originalvars_, other.expressions_);
     }
-    return this;
+    return *this;
   }
 
   ~DynamicMathExpressionBase()
@@ -273,22 +486,60 @@ public:
     return expressions_;
   }
 
+  /**
+   * \note Reentrant, may be called concurrently from several threads.
+   */
   void evaluate(const DynamicVector<DomainFieldType>& arg, FieldVector<RangeFieldType, range_dim>& ret) const
   {
-    std::lock_guard<std::mutex> guard(mutex_);
     // check for sizes
     if (arg.size() != originalvars_.size())
       DUNE_THROW(Common::Exceptions::shapes_do_not_match,
                  "arg.size(): " << arg.size() << "\n   "
                                 << "variables.size(): " << originalvars_.size());
-    // copy arg
+    double args[maxDimDomain];
     for (size_t ii = 0; ii < originalvars_.size(); ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
+      args[ii] = arg[ii];
+    evaluate(args, ret);
+  }
+
+  /**
+   * \brief Evaluates without any checks, args has to hold the values of all variables() (in this order).
+   * \note  Reentrant, may be called concurrently from several threads.
+   */
+  void evaluate(const double* args, FieldVector<RangeFieldType, range_dim>& ret) const
+  {
+    double* stack = internal::math_expression_stack(stack_size_);
     for (size_t ii = 0; ii < range_dim; ++ii)
-      ret[ii] = op_[ii]->Val();
+      ret[ii] = op_[ii]->Val(arg_, int(originalvars_.size()), args, stack);
   }
 
+  /**
+   * \brief Decomposes the expressions affinely w.r.t. their first num_variables variables, see AffineDecomposition.
+   *
+   * \return false if not all expressions are (detectably) affine in these variables. Otherwise true, and
+   *         components[0][ii] is the ii-th expression with all these variables set to zero, components[kk + 1][ii]
+   *         its coefficient of the kk-th variable (none of which depends on any of these variables).
+   */
+  bool affine_decomposition(const size_t num_variables, std::vector<std::vector<std::string>>& components) const
+  {
+    if (num_variables > originalvars_.size())
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "num_variables: " << num_variables << "\n   "
+                                   << "variables.size(): " << originalvars_.size());
+    std::vector<ROperation> decomposition(num_variables + 1);
+    components = std::vector<std::vector<std::string>>(num_variables + 1, std::vector<std::string>(range_dim));
+    for (size_t ii = 0; ii < range_dim; ++ii) {
+      if (!AffineDecomposition(*op_[ii], int(num_variables), var_arg_, decomposition.data()))
+        return false;
+      for (size_t kk = 0; kk <= num_variables; ++kk) {
+        char* tmp = decomposition[kk].Expr();
+        components[kk][ii] = tmp;
+        delete[] tmp;
+      }
+    }
+    return true;
+  } // ... affine_decomposition(...)
+
 private:
   void setup(const std::vector<std::string>& vars, const std::vector<std::string>& exprs)
   {
@@ -318,14 +569,17 @@ private:
     for (size_t ii = variables_.size(); ii < maxDimDomain; ++ii)
       variables_.push_back("this_is_a_long_dummy_name_to_make_sure_it_is_not_used_" + Common::to_string(ii));
     assert(variables_.size() == maxDimDomain);
-    // create expressions
+    // create expressions, the values stored in arg_ are never used, only their addresses identify the variables
     for (size_t ii = 0; ii < maxDimDomain; ++ii) {
-      arg_[ii] = new DomainFieldType(0.0);
-      var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_[ii]);
+      arg_[ii] = 0.;
+      var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_ + ii);
       vararray_[ii] = var_arg_[ii];
     }
+    stack_size_ = 0;
     for (size_t ii = 0; ii < range_dim; ++ii) {
       op_[ii] = new ROperation(expressions_[ii].c_str(), maxDimDomain, vararray_);
+      *op_[ii] = op_[ii]->Simplify();
+      stack_size_ = std::max(stack_size_, size_t(op_[ii]->StackSize()));
     }
   } // void setup(const std::string& var, const std::vector< std::string >& expressions)
 
@@ -336,7 +590,6 @@ private:
     }
     for (size_t ii = 0; ii < maxDimDomain; ++ii) {
       delete var_arg_[ii];
-      delete arg_[ii];
     }
   } // void cleanup()
 
@@ -344,11 +597,11 @@ private:
   std::vector<std::string> variables_;
   std::vector<std::string> expressions_;
   size_t actualDimRange_;
-  mutable DomainFieldType* arg_[maxDimDomain];
+  double arg_[maxDimDomain];
   RVar* var_arg_[maxDimDomain];
   RVar* vararray_[maxDimDomain];
   ROperation* op_[range_dim];
-  mutable std::mutex mutex_;
+  size_t stack_size_;
 }; // class DynamicMathExpressionBase
 
 
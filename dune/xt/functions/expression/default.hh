@@ -41,7 +41,7 @@ class ExpressionFunction : public FunctionInterface<d, r, rC, RangeField>
 
   using typename BaseType::DomainFieldType;
   using MathExpressionFunctionType = MathExpressionBase<DomainFieldType, d, RangeField, r * rC>;
-  using MathExpressionGradientType = MathExpressionBase<DomainFieldType, d, RangeField, d>;
+  using MathExpressionValueAndJacobianType = MathExpressionBase<DomainFieldType, d, RangeField, r * rC * (d + 1)>;
 
 public:
   using typename BaseType::RangeReturnType;
@@ -67,6 +67,7 @@ public:
     config["gradient.2"] = "[1 0 0; pi*cos(x[0]*pi) 0 0; exp(x[0]) 0 0]";
     config["order"] = "3";
     config["name"] = static_id();
+    config["backend"] = "interpreter";
     return config;
   } // ... defaults(...)
 
@@ -95,9 +96,10 @@ public:
    *  [[0 0 ; cos(x[0]) 0] , [0 0 ; 0 1]] would be the gradient_expression corresponding to the expression above
    (if
    *  d = r = rC = 2)
-   * Note: it is optional to provide a gradient if you do not want to use jacobian().
+   * Note: it is optional to provide a gradient if you do not want to use jacobian(), see also the ctor below.
    * \param ord order of the Expression function
    * \param nm name of the Expression function
+   * \param backend "interpreter", "vectorized" or "jit", see MathExpressionBase
    *
    * For this example the correct constructor call is
    * FunctionType function("x", {{"1", "sin(x[0])"}, {"2", "x[1]"}}, {{{"0", "0"}, {"cos(x[0])", "0"}}, {{"0", "0"},
@@ -107,26 +109,46 @@ public:
                      const Common::FieldMatrix<std::string, r, rC>& expressions,
                      const Common::FieldVector<Common::FieldMatrix<std::string, rC, d>, r>& gradient_expressions,
                      const size_t ord,
-                     const std::string nm = static_id())
-    : function_(new MathExpressionFunctionType(variable, matrix_to_vector(expressions)))
+                     const std::string nm = static_id(),
+                     const std::string backend = defaults().template get<std::string>("backend"))
+    : function_(new MathExpressionFunctionType(variable, matrix_to_vector(expressions), backend))
     , order_(ord)
     , name_(nm)
   {
-    build_gradients(variable, gradient_expressions);
+    Common::FieldVector<std::string, r * rC * (d + 1)> value_and_jacobian_expressions("");
+    for (size_t rr = 0; rr < r; ++rr)
+      for (size_t cc = 0; cc < rC; ++cc) {
+        value_and_jacobian_expressions[rr * rC + cc] = expressions[rr][cc];
+        assert(gradient_expressions[rr][cc].size() >= d);
+        for (size_t dd = 0; dd < d; ++dd)
+          value_and_jacobian_expressions[r * rC + (rr * rC + cc) * d + dd] = gradient_expressions[rr][cc][dd];
+      }
+    value_and_jacobian_ =
+        std::make_shared<const MathExpressionValueAndJacobianType>(variable, value_and_jacobian_expressions, backend);
   }
 
   /**
    * @brief ExpressionFunction without given gradient
    *
+   * \param derive_gradients if true, the gradients are derived symbolically from the expressions (and jacobian() may
+   *                         be used), otherwise jacobian() is not available
    */
   ExpressionFunction(const std::string& variable,
                      const Common::FieldMatrix<std::string, r, rC>& expressions,
                      const size_t ord,
-                     const std::string nm = static_id())
-    : function_(new MathExpressionFunctionType(variable, matrix_to_vector(expressions)))
+                     const std::string nm = static_id(),
+                     const std::string backend = defaults().template get<std::string>("backend"),
+                     const bool derive_gradients = false)
+    : function_(new MathExpressionFunctionType(variable, matrix_to_vector(expressions), backend))
     , order_(ord)
     , name_(nm)
-  {}
+  {
+    if (derive_gradients) {
+      const auto expression_vector = matrix_to_vector(expressions);
+      value_and_jacobian_ = std::make_shared<const MathExpressionValueAndJacobianType>(
+          variable, std::vector<std::string>(expression_vector.begin(), expression_vector.end()), true, backend);
+    }
+  }
 
   ExpressionFunction(const ThisType& other) = default;
 
@@ -136,7 +158,7 @@ public:
       function_ = other.function_;
       order_ = other.order_;
       name_ = other.name_;
-      gradients_ = other.gradients_;
+      value_and_jacobian_ = other.value_and_jacobian_;
     }
     return *this;
   }
@@ -146,6 +168,14 @@ public:
     return name_;
   }
 
+  /**
+   * \brief The backend which is actually used to evaluate the expression, see MathExpressionBase::backend.
+   */
+  std::string backend() const
+  {
+    return function_->backend();
+  }
+
   int order(const Common::Parameter& /*param*/ = {}) const override final
   {
     return static_cast<int>(order_);
@@ -172,20 +202,78 @@ public:
   using BaseType::jacobian;
 
   DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
-                                     const Common::Parameter& /*param*/ = {}) const override final
+                                     const Common::Parameter& param = {}) const override final
+  {
+    RangeReturnType value;
+    DerivativeRangeReturnType ret;
+    evaluate_with_jacobian(point_in_global_coordinates, value, ret, param);
+    return ret;
+  } // ... jacobian(...)
+
+  /**
+   * \brief Evaluates the function and its jacobian at once, sharing all common subexpressions.
+   */
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
   {
-    if (gradients_.size() != r)
-      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given on construction!");
-
-    DerivativeRangeReturnType ret(Common::FieldMatrix<double, rC, d>(0.));
-    for (size_t cc = 0; cc < r; ++cc) {
-      assert(gradients_[cc].size() == rC);
-      for (size_t rr = 0; rr < rC; ++rr) {
-        gradients_[cc][rr]->evaluate(point_in_global_coordinates, ret[cc][rr]);
-        check_value(point_in_global_coordinates, ret[cc][rr]);
+    if (!value_and_jacobian_)
+      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given (or derived) on construction!");
+    Common::FieldVector<RangeFieldType, r * rC * (d + 1)> tmp_vector_;
+    value_and_jacobian_->evaluate(point_in_global_coordinates, tmp_vector_);
+    for (size_t rr = 0; rr < r; ++rr) {
+      for (size_t cc = 0; cc < rC; ++cc) {
+        value[rr][cc] = tmp_vector_[rr * rC + cc];
+        for (size_t dd = 0; dd < d; ++dd)
+          jacobian[rr][cc][dd] = tmp_vector_[r * rC + (rr * rC + cc) * d + dd];
+        check_value(point_in_global_coordinates, jacobian[rr][cc]);
       }
+      check_value(point_in_global_coordinates, value[rr]);
     }
-    return ret;
+  } // ... evaluate_with_jacobian(...)
+
+  /**
+   * \brief Evaluates the function in all points at once, see MathExpressionBase::evaluate_blockwise.
+   * \attention results will be resized!
+   */
+  void evaluate(const std::vector<DomainType>& points,
+                std::vector<RangeReturnType>& results,
+                const Common::Parameter& /*param*/ = {}) const
+  {
+    results.resize(points.size());
+    function_->evaluate_blockwise(points.size(),
+                                  [&](const size_t pp) -> const DomainType& { return points[pp]; },
+                                  [&](const size_t pp, const size_t ii, const double& value) {
+                                    results[pp][ii / rC][ii % rC] = value;
+                                  });
+    for (size_t pp = 0; pp < points.size(); ++pp)
+      for (size_t rr = 0; rr < r; ++rr)
+        check_value(points[pp], results[pp][rr]);
+  } // ... evaluate(...)
+
+  /**
+   * \brief Evaluates the jacobian in all points at once, see MathExpressionBase::evaluate_blockwise.
+   * \attention results will be resized!
+   */
+  void jacobian(const std::vector<DomainType>& points,
+                std::vector<DerivativeRangeReturnType>& results,
+                const Common::Parameter& /*param*/ = {}) const
+  {
+    if (!value_and_jacobian_)
+      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given (or derived) on construction!");
+    results.resize(points.size());
+    value_and_jacobian_->evaluate_blockwise(points.size(),
+                                            [&](const size_t pp) -> const DomainType& { return points[pp]; },
+                                            [&](const size_t pp, const size_t ii, const double& value) {
+                                              if (ii >= r * rC)
+                                                results[pp][(ii - r * rC) / (rC * d)][(ii - r * rC) / d % rC]
+                                                       [(ii - r * rC) % d] = value;
+                                            });
+    for (size_t pp = 0; pp < points.size(); ++pp)
+      for (size_t rr = 0; rr < r; ++rr)
+        for (size_t cc = 0; cc < rC; ++cc)
+          check_value(points[pp], results[pp][rr][cc]);
   } // ... jacobian(...)
 
 
@@ -225,23 +313,10 @@ public:
   }
 
 private:
-  void build_gradients(const std::string& variable,
-                       const Common::FieldVector<Common::FieldMatrix<std::string, rC, d>, r>& gradient_expressions)
-  {
-    for (size_t cc = 0; cc < r; ++cc) {
-      gradients_.emplace_back(std::vector<std::shared_ptr<const MathExpressionGradientType>>());
-      for (size_t rr = 0; rr < rC; ++rr) {
-        const auto& gradient_expression = gradient_expressions[cc][rr];
-        assert(gradient_expression.size() >= d);
-        gradients_[cc].emplace_back(new MathExpressionGradientType(variable, gradient_expression));
-      }
-    }
-  } // ... build_gradients(...)
-
   std::shared_ptr<const MathExpressionFunctionType> function_;
   size_t order_;
   std::string name_;
-  std::vector<std::vector<std::shared_ptr<const MathExpressionGradientType>>> gradients_;
+  std::shared_ptr<const MathExpressionValueAndJacobianType> value_and_jacobian_;
 }; // class ExpressionFunction
 
 
@@ -253,7 +328,7 @@ class ExpressionFunction<d, r, 1, RangeField> : public FunctionInterface<d, r, 1
 
   using typename BaseType::DomainFieldType;
   using MathExpressionFunctionType = MathExpressionBase<DomainFieldType, d, RangeField, r>;
-  using MathExpressionGradientType = MathExpressionBase<DomainFieldType, d, RangeField, d>;
+  using MathExpressionValueAndJacobianType = MathExpressionBase<DomainFieldType, d, RangeField, r * (d + 1)>;
 
 public:
   using typename BaseType::DerivativeRangeReturnType;
@@ -276,6 +351,7 @@ public:
     config["gradient"] = "[1 0 0; pi*cos(pi*x[0]) 0 0; exp(x[0]) 0 0]";
     config["order"] = "3";
     config["name"] = static_id();
+    config["backend"] = "interpreter";
     if (sub_name.empty())
       return config;
     else {
@@ -295,32 +371,50 @@ public:
    * {"x[1]","x[0]"}.
    * For r = 2 we have for example the expression = {"sin(x[0])", "x[1]*x[1]"} with the gradient
    * {{"cos(x[0])", "0"}, {"0", "2*x[1]"}}.
+   * The values and gradients are evaluated by a single program, sharing common subexpressions, see also
+   * evaluate_with_jacobian().
    */
 
   ExpressionFunction(const std::string& variable,
                      const Common::FieldVector<std::string, r>& expressions,
                      const Common::FieldMatrix<std::string, r, d>& gradient_expressions,
                      const size_t ord,
-                     const std::string nm = static_id())
-    : function_(new MathExpressionFunctionType(variable, expressions))
+                     const std::string nm = static_id(),
+                     const std::string backend = defaults().template get<std::string>("backend"))
+    : function_(new MathExpressionFunctionType(variable, expressions, backend))
     , order_(ord)
     , name_(nm)
   {
-    build_gradients(variable, gradient_expressions);
+    Common::FieldVector<std::string, r * (d + 1)> value_and_jacobian_expressions("");
+    for (size_t rr = 0; rr < r; ++rr) {
+      value_and_jacobian_expressions[rr] = expressions[rr];
+      for (size_t dd = 0; dd < d; ++dd)
+        value_and_jacobian_expressions[r + rr * d + dd] = gradient_expressions[rr][dd];
+    }
+    value_and_jacobian_ =
+        std::make_shared<const MathExpressionValueAndJacobianType>(variable, value_and_jacobian_expressions, backend);
   }
 
   /**
    * @brief ExpressionFunction without given gradient
    *
+   * \param derive_gradients if true, the gradients are derived symbolically from the expressions (and jacobian() may
+   *                         be used), otherwise jacobian() is not available
    */
   ExpressionFunction(const std::string& variable,
                      const Common::FieldVector<std::string, r>& expressions,
                      const size_t ord,
-                     const std::string nm = static_id())
-    : function_(new MathExpressionFunctionType(variable, expressions))
+                     const std::string nm = static_id(),
+                     const std::string backend = defaults().template get<std::string>("backend"),
+                     const bool derive_gradients = false)
+    : function_(new MathExpressionFunctionType(variable, expressions, backend))
     , order_(ord)
     , name_(nm)
-  {}
+  {
+    if (derive_gradients)
+      value_and_jacobian_ = std::make_shared<const MathExpressionValueAndJacobianType>(
+          variable, std::vector<std::string>(expressions.begin(), expressions.end()), true, backend);
+  }
 
 #if !DUNE_XT_WITH_PYTHON_BINDINGS
   ExpressionFunction(const ThisType& other) = default;
@@ -332,7 +426,7 @@ public:
       function_ = other.function_;
       order_ = other.order_;
       name_ = other.name_;
-      gradients_ = other.gradients_;
+      value_and_jacobian_ = other.value_and_jacobian_;
     }
     return *this;
   }
@@ -342,6 +436,14 @@ public:
     return name_;
   }
 
+  /**
+   * \brief The backend which is actually used to evaluate the expression, see MathExpressionBase::backend.
+   */
+  std::string backend() const
+  {
+    return function_->backend();
+  }
+
   int order(const Common::Parameter& /*param*/ = {}) const override final
   {
     return static_cast<int>(order_);
@@ -361,18 +463,74 @@ public:
   using BaseType::jacobian;
 
   DerivativeRangeReturnType jacobian(const DomainType& point_in_global_coordinates,
-                                     const Common::Parameter& /*param*/ = {}) const override final
+                                     const Common::Parameter& param = {}) const override final
   {
-    if (gradients_.size() != r)
-      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given on construction!");
-    DerivativeRangeReturnType ret(0.);
-    for (size_t rr = 0; rr < r; ++rr) {
-      gradients_[rr]->evaluate(point_in_global_coordinates, ret[rr]);
-      check_value(point_in_global_coordinates, ret[rr]);
-    }
+    RangeReturnType value;
+    DerivativeRangeReturnType ret;
+    evaluate_with_jacobian(point_in_global_coordinates, value, ret, param);
     return ret;
   }
 
+  /**
+   * \brief Evaluates the function and its jacobian at once, sharing all common subexpressions.
+   */
+  void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
+  {
+    if (!value_and_jacobian_)
+      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given (or derived) on construction!");
+    Common::FieldVector<RangeFieldType, r * (d + 1)> tmp_vector_;
+    value_and_jacobian_->evaluate(point_in_global_coordinates, tmp_vector_);
+    for (size_t rr = 0; rr < r; ++rr) {
+      value[rr] = tmp_vector_[rr];
+      for (size_t dd = 0; dd < d; ++dd)
+        jacobian[rr][dd] = tmp_vector_[r + rr * d + dd];
+      check_value(point_in_global_coordinates, jacobian[rr]);
+    }
+    check_value(point_in_global_coordinates, value);
+  } // ... evaluate_with_jacobian(...)
+
+  /**
+   * \brief Evaluates the function in all points at once, see MathExpressionBase::evaluate_blockwise.
+   * \attention results will be resized!
+   */
+  void evaluate(const std::vector<DomainType>& points,
+                std::vector<RangeReturnType>& results,
+                const Common::Parameter& /*param*/ = {}) const
+  {
+    results.resize(points.size());
+    function_->evaluate_blockwise(
+        points.size(),
+        [&](const size_t pp) -> const DomainType& { return points[pp]; },
+        [&](const size_t pp, const size_t rr, const double& value) { results[pp][rr] = value; });
+    for (size_t pp = 0; pp < points.size(); ++pp)
+      check_value(points[pp], results[pp]);
+  } // ... evaluate(...)
+
+  /**
+   * \brief Evaluates the jacobian in all points at once, see MathExpressionBase::evaluate_blockwise.
+   * \attention results will be resized!
+   */
+  void jacobian(const std::vector<DomainType>& points,
+                std::vector<DerivativeRangeReturnType>& results,
+                const Common::Parameter& /*param*/ = {}) const
+  {
+    if (!value_and_jacobian_)
+      DUNE_THROW(NotImplemented, "Do not call jacobian() if no gradients are given (or derived) on construction!");
+    results.resize(points.size());
+    value_and_jacobian_->evaluate_blockwise(points.size(),
+                                            [&](const size_t pp) -> const DomainType& { return points[pp]; },
+                                            [&](const size_t pp, const size_t ii, const double& value) {
+                                              if (ii >= r)
+                                                results[pp][(ii - r) / d][(ii - r) % d] = value;
+                                            });
+    for (size_t pp = 0; pp < points.size(); ++pp)
+      for (size_t rr = 0; rr < r; ++rr)
+        check_value(points[pp], results[pp][rr]);
+  } // ... jacobian(...)
+
 private:
   template <class V>
   void check_value(const DomainType& point_in_global_coordinates, const V& value) const
@@ -409,22 +567,10 @@ private:
 #endif // NDEBUG
   }
 
-private:
-  void build_gradients(const std::string& variable, const Common::FieldMatrix<std::string, r, d>& gradient_expressions)
-  {
-    for (size_t rr = 0; rr < r; ++rr)
-      gradients_.emplace_back(new MathExpressionGradientType(variable, gradient_expressions[rr]));
-  }
-
-  void build_gradients(const std::string& variable, const Common::FieldVector<std::string, d>& gradient_expression)
-  {
-    gradients_.emplace_back(new MathExpressionGradientType(variable, gradient_expression));
-  }
-
   std::shared_ptr<const MathExpressionFunctionType> function_;
   size_t order_;
   std::string name_;
-  std::vector<std::shared_ptr<const MathExpressionGradientType>> gradients_;
+  std::shared_ptr<const MathExpressionValueAndJacobianType> value_and_jacobian_;
 }; // class ExpressionFunction
 
 
@@ -0,0 +1,221 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mathexpr.hh"
+#include "jit.hh"
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace internal {
+namespace {
+
+
+std::string jit_environment(const char* name, const std::string& default_value)
+{
+  const char* value = std::getenv(name);
+  return (value != nullptr && value[0] != '\0') ? std::string(value) : default_value;
+}
+
+
+// empty if neither of DUNE_XT_FUNCTIONS_JIT_CACHE_DIR, XDG_CACHE_HOME and HOME is set
+std::string jit_cache_dir()
+{
+  const std::string home = jit_environment("HOME", "");
+  const std::string cache_home = jit_environment("XDG_CACHE_HOME", home.empty() ? "" : home + "/.cache");
+  return jit_environment("DUNE_XT_FUNCTIONS_JIT_CACHE_DIR",
+                         cache_home.empty() ? "" : cache_home + "/dune-xt-functions-jit");
+}
+
+
+// FNV-1a, which is stable across runs (as opposed to std::hash)
+std::string jit_hash(const std::string& str)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const char& c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+  return std::string(buffer);
+}
+
+
+/**
+ * Creates path (and its parents), and checks that only the current user may place files in it (since the shared
+ * objects therein are loaded): path has to be a directory (not a symlink) owned by the current user with mode 0700.
+ */
+bool jit_make_dirs(const std::string& path)
+{
+  if (path.empty())
+    return false;
+  for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+    mkdir(path.substr(0, pos).c_str(), 0700);
+  mkdir(path.c_str(), 0700);
+  struct stat info;
+  return lstat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode) && info.st_uid == getuid()
+         && (info.st_mode & 07777) == 0700;
+} // ... jit_make_dirs(...)
+
+
+bool jit_file_exists(const std::string& path)
+{
+  struct stat info;
+  return lstat(path.c_str(), &info) == 0;
+}
+
+
+/// Only regular files (no symlinks) owned by the current user, which nobody else may write to, are loaded.
+bool jit_is_trusted_file(const std::string& path)
+{
+  struct stat info;
+  return lstat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode) && info.st_uid == getuid()
+         && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+
+/**
+ * Runs compiler (with the whitespace separated flags and the given arguments) without a shell, writing its output to
+ * log. Returns true if it succeeded.
+ */
+bool jit_run_compiler(const std::string& compiler,
+                      const std::string& flags,
+                      const std::vector<std::string>& arguments,
+                      const std::string& log)
+{
+  std::vector<std::string> args{compiler};
+  std::istringstream flags_stream(flags);
+  for (std::string flag; flags_stream >> flag;)
+    args.push_back(flag);
+  args.insert(args.end(), arguments.begin(), arguments.end());
+  std::vector<char*> argv;
+  for (auto& arg : args)
+    argv.push_back(&arg[0]);
+  argv.push_back(nullptr);
+  const pid_t pid = fork();
+  if (pid < 0)
+    return false;
+  if (pid == 0) {
+    // only async-signal-safe functions from here on
+    const int log_fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (log_fd >= 0) {
+      dup2(log_fd, STDOUT_FILENO);
+      dup2(log_fd, STDERR_FILENO);
+      close(log_fd);
+    }
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0)
+    if (errno != EINTR)
+      return false;
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+} // ... jit_run_compiler(...)
+
+
+MathExpressionJit::CompiledType jit_load(const std::string& library)
+{
+  MathExpressionJit::CompiledType compiled{nullptr, nullptr};
+  if (!jit_is_trusted_file(library))
+    return compiled;
+  void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr)
+    return compiled;
+  // the handle is never closed, the functions may be used until the end of the program
+  compiled.evaluate =
+      reinterpret_cast<MathExpressionJit::EvaluateType>(dlsym(handle, "dune_xt_functions_jit_evaluate"));
+  compiled.evaluate_block =
+      reinterpret_cast<MathExpressionJit::EvaluateBlockType>(dlsym(handle, "dune_xt_functions_jit_evaluate_block"));
+  if (compiled.evaluate == nullptr || compiled.evaluate_block == nullptr)
+    compiled = {nullptr, nullptr};
+  return compiled;
+} // ... jit_load(...)
+
+
+} // namespace
+
+
+MathExpressionJit::CompiledType
+MathExpressionJit::compile(const std::string* expressions, const size_t num_expressions, const size_t num_args)
+{
+  std::ostringstream source;
+  source << CCodeDefinitions() << "\n"
+         << "extern \"C\" void dune_xt_functions_jit_evaluate(const double* x, double* y)\n{\n";
+  for (size_t ii = 0; ii < num_expressions; ++ii)
+    source << "  y[" << ii << "] = " << expressions[ii] << ";\n";
+  source << "}\n\n"
+         << "extern \"C\" void dune_xt_functions_jit_evaluate_block(int n, const double* x, double* y)\n{\n"
+         << "  for (int i = 0; i < n; ++i) {\n"
+         << "    double xx[" << num_args << "];\n"
+         << "    double yy[" << num_expressions << "];\n"
+         << "    for (int k = 0; k < " << num_args << "; ++k)\n"
+         << "      xx[k] = x[k * n + i];\n"
+         << "    dune_xt_functions_jit_evaluate(xx, yy);\n"
+         << "    for (int k = 0; k < " << num_expressions << "; ++k)\n"
+         << "      y[k * n + i] = yy[k];\n"
+         << "  }\n"
+         << "}\n";
+  const std::string compiler = jit_environment("DUNE_XT_FUNCTIONS_JIT_CXX", "c++");
+  const std::string flags = jit_environment("DUNE_XT_FUNCTIONS_JIT_CXXFLAGS", "-O3");
+  const std::string hash = jit_hash(compiler + "\n" + flags + "\n" + source.str());
+
+  static std::mutex mutex;
+  static std::map<std::string, CompiledType> loaded;
+  std::lock_guard<std::mutex> guard(mutex);
+  const auto search_result = loaded.find(hash);
+  if (search_result != loaded.end())
+    return search_result->second;
+
+  const CompiledType failed{nullptr, nullptr};
+  const std::string cache_dir = jit_cache_dir();
+  if (!jit_make_dirs(cache_dir))
+    return failed;
+  const std::string library = cache_dir + "/" + hash + ".so";
+  if (!jit_file_exists(library)) {
+    // compile to process specific files and rename afterwards, so that concurrent processes do not interfere
+    const std::string prefix = cache_dir + "/" + hash + "." + std::to_string(static_cast<long>(getpid()));
+    {
+      std::ofstream file(prefix + ".cc");
+      file << source.str();
+      if (!file)
+        return failed;
+    }
+    if (!jit_run_compiler(compiler, flags, {"-shared", "-fPIC", "-o", prefix + ".so", prefix + ".cc"}, prefix + ".log")
+        || chmod((prefix + ".so").c_str(), 0700) != 0 || std::rename((prefix + ".so").c_str(), library.c_str()) != 0)
+      return failed;
+    std::rename((prefix + ".cc").c_str(), (cache_dir + "/" + hash + ".cc").c_str());
+    std::remove((prefix + ".log").c_str());
+  }
+  const auto compiled = jit_load(library);
+  if (compiled.evaluate != nullptr)
+    loaded[hash] = compiled;
+  return compiled;
+} // ... MathExpressionJit::compile(...)
+
+
+} // namespace internal
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
@@ -0,0 +1,64 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_EXPRESSION_JIT_HH
+#define DUNE_XT_FUNCTIONS_EXPRESSION_JIT_HH
+
+#include <string>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace internal {
+
+
+/**
+ * \brief Compiles expressions to native code at runtime, used by MathExpressionBase with the "jit" backend.
+ *
+ *        The generated source is compiled into a shared object by the system compiler, which is then loaded with
+ *        dlopen. The shared objects are cached on disk (keyed by a hash of the source, the compiler and its flags) and
+ *        within the process, so each set of expressions is compiled only once. The results coincide with the ones of
+ *        the interpreter up to rounding (the compiler may simplify, e.g., pow(x, 2) to x*x). The behaviour can be
+ *        adjusted by the following environment variables:
+ *          - DUNE_XT_FUNCTIONS_JIT_CXX:       compiler to use (default: c++)
+ *          - DUNE_XT_FUNCTIONS_JIT_CXXFLAGS:  whitespace separated flags passed to the compiler (default: -O3)
+ *          - DUNE_XT_FUNCTIONS_JIT_CACHE_DIR: cache directory (default: $XDG_CACHE_HOME/dune-xt-functions-jit, with
+ *                                             $XDG_CACHE_HOME defaulting to $HOME/.cache)
+ *
+ *        Since the cached shared objects are loaded into the process, the cache directory is only used if it is owned
+ *        by the current user, not a symlink and has mode 0700, and only shared objects owned by the current user and
+ *        not writable by others are loaded. Otherwise (as if no compiler is available), the interpreter is used.
+ */
+class MathExpressionJit
+{
+public:
+  /// y = f(x), for a single point
+  using EvaluateType = void (*)(const double* /*x*/, double* /*y*/);
+  /// Same as EvaluateType, for num_points points given as structure of arrays, as in ROperation::Val.
+  using EvaluateBlockType = void (*)(int /*num_points*/, const double* /*x*/, double* /*y*/);
+
+  struct CompiledType
+  {
+    EvaluateType evaluate;
+    EvaluateBlockType evaluate_block;
+  };
+
+  /**
+   * \brief Compiles the given component expressions (as obtained from ROperation::CCode, using the arguments x[0], ...,
+   *        x[num_args - 1]).
+   * \return The compiled functions, both nullptr if compiling or loading failed.
+   */
+  static CompiledType compile(const std::string* expressions, const size_t num_expressions, const size_t num_args);
+}; // class MathExpressionJit
+
+
+} // namespace internal
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_EXPRESSION_JIT_HH
@@ -30,9 +30,43 @@ This software comes with absolutely no warranty.
 
 */
 
+#include <stdint.h>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+
 #include "mathexpr.hh"
 
 
+// Writes x as sprintf(s, uppercase ? "%.<precision>G" : "%.<precision>g", x) in the "C" locale would, regardless of
+// the global locale (which may, e.g., use a decimal comma).
+static void DoubleToStr(char* s, size_t size, double x, int precision, bool uppercase)
+{
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  if (uppercase)
+    stream << std::uppercase;
+  stream << std::setprecision(precision) << x;
+  snprintf(s, size, "%s", stream.str().c_str());
+}
+
+// Reads a number as atof in the "C" locale would, regardless of the global locale.
+static double StrToDouble(const char* s)
+{
+  std::istringstream stream(s);
+  stream.imbue(std::locale::classic());
+  double x = 0.;
+  stream >> x;
+  // on overflow, the stream fails and yields +-DBL_MAX (which is ErrVal), whereas atof yields +-inf
+  if (stream.fail() && std::abs(x) == std::numeric_limits<double>::max())
+    x = std::copysign(std::numeric_limits<double>::infinity(), x);
+  return x;
+}
+
+
 char* MidStr(const char* s, int i1, int i2)
 {
   if (i1 < 0 || i2 >= (int)strlen(s) || i1 > i2) {
@@ -975,7 +1009,7 @@ ROperation::ROperation(const char* sp, int nvar, PRVar* ppvarp, int nfuncp, PRFu
   }
   if (IsTNumeric(s)) {
     op = Num;
-    ValC = atof(s);
+    ValC = StrToDouble(s);
     mmb1 = NULL;
     mmb2 = NULL;
     goto fin;
@@ -1489,6 +1523,272 @@ ROperation ROperation::Substitute(const RVar& var,
   return r;
 }
 
+signed char IsConstant(const ROperation& rop) // Contains neither variables nor functions
+{
+  if (rop.op == Var || rop.op == Fun || rop.op == ErrOp)
+    return 0;
+  return ((rop.mmb1 == NULL || IsConstant(*rop.mmb1)) && (rop.mmb2 == NULL || IsConstant(*rop.mmb2)));
+}
+
+signed char IsMinusOne(const ROperation& rop)
+{
+  return (rop.op == Opp && *rop.mmb2 == 1.);
+}
+
+PROperation DetachMember(PROperation pop) // Deletes pop but not its second member, which is returned
+{
+  PROperation pmmb = pop->mmb2;
+  pop->mmb2 = NULL;
+  delete pop;
+  return pmmb;
+}
+
+void ROperation::SimplifyNode()
+{
+  if (mmb1 != NULL)
+    mmb1->SimplifyNode();
+  if (mmb2 != NULL)
+    mmb2->SimplifyNode();
+  if (op != Juxt && op != Num && !(op == Opp && mmb2->op == Num) && IsConstant(*this)) {
+    BuildCode();
+    double v = Val();
+    if (v != ErrVal && v - v == 0) { // Errors, infinities and NaN are not folded
+      *this = ROperation(v);
+      return;
+    }
+  }
+  PROperation pop = NULL; // Member which replaces this operation
+  switch (op) {
+    case Add:
+      if (*mmb1 == 0.)
+        pop = mmb2;
+      else if (*mmb2 == 0.)
+        pop = mmb1;
+      else if (mmb2->op == Opp) { // a+(-b) -> a-b
+        op = Sub;
+        mmb2 = DetachMember(mmb2);
+      } else if (mmb1->op == Opp) { // (-a)+b -> b-a
+        op = Sub;
+        pop = DetachMember(mmb1);
+        mmb1 = mmb2;
+        mmb2 = pop;
+        pop = NULL;
+      }
+      break;
+    case Sub:
+      if (*mmb2 == 0.)
+        pop = mmb1;
+      else if (*mmb1 == 0.) { // 0-b -> -b
+        op = Opp;
+        delete mmb1;
+        mmb1 = NULL;
+      } else if (mmb2->op == Opp) { // a-(-b) -> a+b
+        op = Add;
+        mmb2 = DetachMember(mmb2);
+      }
+      break;
+    case Mult:
+      if (*mmb1 == 0. || *mmb2 == 0.) {
+        *this = ROperation(0.);
+        return;
+      }
+      if (*mmb1 == 1.)
+        pop = mmb2;
+      else if (*mmb2 == 1.)
+        pop = mmb1;
+      else if (IsMinusOne(*mmb1)) {
+        op = Opp;
+        delete mmb1;
+        mmb1 = NULL;
+      } else if (IsMinusOne(*mmb2)) {
+        op = Opp;
+        delete mmb2;
+        mmb2 = mmb1;
+        mmb1 = NULL;
+      }
+      break;
+    case Div:
+      if (*mmb1 == 0. && !(*mmb2 == 0.)) { // 0/a -> 0, as for 0*a (0/0 is kept)
+        *this = ROperation(0.);
+        return;
+      }
+      if (*mmb2 == 1.)
+        pop = mmb1;
+      break;
+    case Pow:
+      if (*mmb2 == 1.)
+        pop = mmb1;
+      else if (*mmb2 == 2. && mmb1->op == Var) { // x^2 -> x*x
+        op = Mult;
+        delete mmb2;
+        mmb2 = new ROperation(*mmb1);
+      }
+      break;
+    default:
+      break;
+  }
+  if (pop == NULL && op == Opp && mmb2->op == Opp) // --a -> a
+    pop = mmb2->mmb2;
+  if (pop != NULL) {
+    ROperation rop(*pop);
+    *this = rop;
+    return;
+  }
+  BuildCode();
+}
+
+ROperation ROperation::Simplify() const
+{
+  ROperation r(*this);
+  r.SimplifyNode();
+  return r;
+}
+
+int ROperation::Replace(const ROperation& target, const ROperation& rop)
+{
+  if (*this == target) {
+    *this = rop;
+    return 1;
+  }
+  int n = 0;
+  if (mmb1 != NULL)
+    n += mmb1->Replace(target, rop);
+  if (mmb2 != NULL)
+    n += mmb2->Replace(target, rop);
+  if (n)
+    BuildCode();
+  return n;
+}
+
+struct CSECandidate
+{
+  PROperation pop;
+  int nnodes;
+  uint64_t hash;
+};
+
+int NNodes(const ROperation& rop)
+{
+  return 1 + (rop.mmb1 != NULL ? NNodes(*rop.mmb1) : 0) + (rop.mmb2 != NULL ? NNodes(*rop.mmb2) : 0);
+}
+
+// Appends the subexpressions of *pop which are worth to be replaced to pcands (*pop itself only if withroot), returns
+// whether *pop contains functions. The hash of *pop is compatible with operator==.
+signed char CollectSubexpressions(
+    PROperation pop, signed char withroot, CSECandidate* pcands, int& ncands, int& nnodes, uint64_t& hash)
+{
+  signed char containfunc = (pop->op == Fun);
+  int nnodes1 = 0, nnodes2 = 0;
+  uint64_t hash1 = 0, hash2 = 0;
+  if (pop->mmb1 != NULL && CollectSubexpressions(pop->mmb1, 1, pcands, ncands, nnodes1, hash1))
+    containfunc = 1;
+  if (pop->mmb2 != NULL && CollectSubexpressions(pop->mmb2, 1, pcands, ncands, nnodes2, hash2))
+    containfunc = 1;
+  nnodes = 1 + nnodes1 + nnodes2;
+  hash = pop->op;
+  if (pop->op == Num && pop->ValC != 0) // 0 == -0
+    memcpy(&hash, &pop->ValC, sizeof(hash));
+  else if (pop->op == Var)
+    hash = (uint64_t)(size_t)pop->pvar->pval;
+  hash = ((hash * 1099511628211ull) ^ hash1) * 1099511628211ull ^ hash2;
+  if (withroot && !containfunc && pop->op != Num && pop->op != Var && pop->op != ErrOp && pop->op != Juxt
+      && !(pop->op == Opp && nnodes == 2)) {
+    pcands[ncands].pop = pop;
+    pcands[ncands].nnodes = nnodes;
+    pcands[ncands].hash = hash;
+    ncands++;
+  }
+  return containfunc;
+}
+
+int CompareSubexpressions(const void* p1, const void* p2) // Largest first, equal hashes next to each other
+{
+  const CSECandidate* c1 = (const CSECandidate*)p1;
+  const CSECandidate* c2 = (const CSECandidate*)p2;
+  if (c1->nnodes != c2->nnodes)
+    return (c1->nnodes > c2->nnodes ? -1 : 1);
+  if (c1->hash != c2->hash)
+    return (c1->hash < c2->hash ? -1 : 1);
+  return 0;
+}
+
+int EliminateCommonSubexpressions(
+    int nops, ROperation** pops, int maxtemps, double* tempvals, PRVar* ptempvars, ROperation** ptemps)
+{
+  int ntemps, ncands, nnodes, n, i, j, k;
+  uint64_t hash;
+  char name[32];
+  for (ntemps = 0; ntemps < maxtemps; ntemps++) {
+    for (nnodes = 0, i = 0; i < nops; i++)
+      nnodes += NNodes(*pops[i]);
+    for (i = 0; i < ntemps; i++)
+      nnodes += NNodes(*ptemps[i]);
+    CSECandidate* pcands = new CSECandidate[nnodes];
+    ncands = 0;
+    for (i = 0; i < nops; i++)
+      CollectSubexpressions(pops[i], 1, pcands, ncands, n, hash);
+    for (i = 0; i < ntemps; i++)
+      CollectSubexpressions(ptemps[i], 0, pcands, ncands, n, hash);
+    qsort(pcands, ncands, sizeof(CSECandidate), &CompareSubexpressions);
+    for (k = -1, i = 0; i < ncands && k == -1; i++)
+      for (j = i + 1; j < ncands && pcands[j].nnodes == pcands[i].nnodes && pcands[j].hash == pcands[i].hash; j++)
+        if (*pcands[j].pop == *pcands[i].pop) {
+          k = i;
+          break;
+        }
+    if (k == -1) {
+      delete[] pcands;
+      break;
+    }
+    ROperation target(*pcands[k].pop);
+    delete[] pcands;
+    snprintf(name, sizeof(name), "cse%d", ntemps);
+    ptempvars[ntemps] = new RVar(name, tempvals + ntemps);
+    ROperation rop(*ptempvars[ntemps]);
+    for (i = 0; i < nops; i++)
+      pops[i]->Replace(target, rop);
+    for (i = 0; i < ntemps; i++)
+      ptemps[i]->Replace(target, rop);
+    ptemps[ntemps] = new ROperation(target);
+  }
+  return ntemps;
+}
+
+signed char ContainsErrVal(const ROperation& rop)
+{
+  if (rop.op == ErrOp || (rop.op == Num && rop.ValC == ErrVal))
+    return 1;
+  if (rop.mmb1 != NULL && ContainsErrVal(*rop.mmb1))
+    return 1;
+  if (rop.mmb2 != NULL && ContainsErrVal(*rop.mmb2))
+    return 1;
+  return 0;
+}
+
+signed char AffineDecomposition(const ROperation& rop, int nvars, const PRVar* ppvars, ROperation* pcomps)
+{
+  int i, j;
+  if (rop.HasError() || ContainsErrVal(rop))
+    return 0;
+  // the derivatives w.r.t. the variables have to be free of them (Diff yields ErrVal where it cannot differentiate)
+  for (i = 0; i < nvars; i++) {
+    ROperation diff = rop.Diff(*ppvars[i]);
+    if (diff.HasError() || ContainsErrVal(diff))
+      return 0;
+    pcomps[i + 1] = diff.Simplify();
+    for (j = 0; j < nvars; j++)
+      if (pcomps[i + 1].ContainVar(*ppvars[j]))
+        return 0;
+  }
+  // the remainder is the value for all variables being zero
+  ROperation zero(0.);
+  pcomps[0] = rop;
+  for (i = 0; i < nvars; i++)
+    pcomps[0] = pcomps[0].Substitute(*ppvars[i], zero);
+  pcomps[0] = pcomps[0].Simplify();
+  return 1;
+}
+
 ROperation ROperation::Diff(const RVar& var) const
 {
   if (!ContainVar(var))
@@ -1588,13 +1888,118 @@ ROperation ROperation::Diff(const RVar& var) const
   };
 }
 
+char* ROperation::CCode(const double* vars, int nvars) const
+{
+  const char* f = NULL;
+  const ROperation *m1 = mmb1, *m2 = mmb2;
+  char *s, *s1 = NULL, *s2 = NULL;
+  switch (op) {
+    case ErrOp:
+      return CopyStr("ErrVal");
+    case Num:
+      if (ValC != ValC)
+        return NULL;
+      s = new char[32];
+      DoubleToStr(s, 32, ValC, 17, false);
+      return s;
+    case Var:
+      if (!(pvarval >= vars && pvarval < vars + nvars))
+        return NULL;
+      s = new char[32];
+      sprintf(s, "x[%d]", (int)(pvarval - vars));
+      return s;
+    case Add:
+      f = "ValAddition";
+      break;
+    case Sub:
+      f = "ValSoustraction";
+      break;
+    case Mult:
+      f = "ValMultiplication";
+      break;
+    case Div:
+      f = "ValDivision";
+      break;
+    case Pow:
+      f = "ValPuissance";
+      break;
+    case NthRoot:
+      f = "ValRacineN";
+      break;
+    case E10:
+      f = "ValPuiss10";
+      break;
+    case Opp:
+      f = "ValOppose";
+      break;
+    case Sin:
+      f = "ValSinus";
+      break;
+    case Sqrt:
+      f = "ValRacine";
+      break;
+    case Ln:
+      f = "ValLogarithme";
+      break;
+    case Exp:
+      f = "ValExponentielle";
+      break;
+    case Cos:
+      f = "ValCosinus";
+      break;
+    case Tg:
+      f = "ValTangente";
+      break;
+    case Atan:
+      if (mmb2->op == Juxt) { // atan(y, x)
+        f = "ValArcTangente2";
+        m1 = mmb2->mmb1;
+        m2 = mmb2->mmb2;
+        if (m1->op == Juxt || m2->op == Juxt)
+          return NULL;
+      } else
+        f = "ValArcTangente";
+      break;
+    case Asin:
+      f = "ValArcSinus";
+      break;
+    case Acos:
+      f = "ValArcCosinus";
+      break;
+    case Abs:
+      f = "ValAbsolu";
+      break;
+    case Juxt:
+    case Fun:
+      return NULL;
+    default:
+      f = "ValFonctionError";
+  }
+  if (m1 != NULL && (s1 = m1->CCode(vars, nvars)) == NULL)
+    return NULL;
+  if ((s2 = m2->CCode(vars, nvars)) == NULL) {
+    if (s1 != NULL)
+      delete[] s1;
+    return NULL;
+  }
+  s = new char[strlen(f) + (s1 != NULL ? strlen(s1) : 0) + strlen(s2) + 8];
+  if (s1 != NULL)
+    sprintf(s, "%s(%s, %s)", f, s1, s2);
+  else
+    sprintf(s, "%s(%s)", f, s2);
+  if (s1 != NULL)
+    delete[] s1;
+  delete[] s2;
+  return s;
+}
+
 char* ValToStr(double x)
 {
   char* s = new char[30];
   if (x == (double)3.141592653589793238462643383279L)
     sprintf(s, "pi");
   else
-    sprintf(s, "%.16G", x);
+    DoubleToStr(s, 30, x, 16, true);
   return s;
 }
 
@@ -1804,171 +2209,664 @@ const double sqrtmaxfloat = sqrt(DBL_MAX);
 const double sqrtminfloat = sqrt(DBL_MIN);
 const double inveps = .1 / DBL_EPSILON;
 
+// The semantics of the operators, shared by the scalar and the block kernels below
+
+inline double ValAddition(double v1, double v2)
+{
+  if (v2 == ErrVal || fabsl(v2) > sqrtmaxfloat || v1 == ErrVal || fabsl(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 + v2;
+}
+inline double ValSoustraction(double v1, double v2)
+{
+  if (v2 == ErrVal || fabsl(v2) > sqrtmaxfloat || v1 == ErrVal || fabsl(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 - v2;
+}
+inline double ValMultiplication(double v1, double v2)
+{
+  if (fabsl(v2) < sqrtminfloat)
+    return 0;
+  if (v2 == ErrVal || fabsl(v2) > sqrtmaxfloat)
+    return ErrVal;
+  if (fabsl(v1) < sqrtminfloat)
+    return 0;
+  if (v1 == ErrVal || fabsl(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 * v2;
+}
+inline double ValDivision(double v1, double v2)
+{
+  if (fabsl(v2) < sqrtminfloat || v2 == ErrVal || fabsl(v2) > sqrtmaxfloat)
+    return ErrVal;
+  if (fabsl(v1) < sqrtminfloat)
+    v1 = 0;
+  else if (v1 == ErrVal || fabsl(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 / v2;
+}
+inline double ValPuissance(double v1, double v2)
+{
+  if (!v1)
+    return 0;
+  if (v2 == ErrVal || v1 == ErrVal || fabsl(v2 * logl(fabsl(v1))) > DBL_MAX_EXP)
+    return ErrVal;
+  return ((v1 > 0 || !fmodl(v2, 1)) ? powl(v1, v2) : ErrVal);
+}
+inline double ValRacineN(double v1, double v2)
+{
+  if (v1 == ErrVal || v2 == ErrVal || !v1 || v2 * logl(fabsl(v1)) < DBL_MIN_EXP)
+    return ErrVal;
+  if (v2 >= 0)
+    return powl(v2, 1 / v1);
+  return ((fabsl(fmodl(v1, 2)) == 1) ? -powl(-v2, 1 / v1) : ErrVal);
+}
+inline double ValPuiss10(double v1, double v2)
+{
+  if (fabsl(v2) < sqrtminfloat)
+    return 0;
+  if (v2 == ErrVal || fabsl(v2) > DBL_MAX_10_EXP)
+    return ErrVal;
+  if (fabsl(v1) < sqrtminfloat)
+    v1 = 0;
+  else if (v1 == ErrVal || fabsl(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 * pow10l(v2);
+}
+inline double ValArcTangente2(double v1, double v2)
+{
+  if (v2 == ErrVal || fabsl(v2) > inveps || v1 == ErrVal || fabsl(v1) > inveps)
+    return ErrVal;
+  return (v1 || v2 ? atan2(v1, v2) : ErrVal);
+}
+inline double ValAbsolu(double v)
+{
+  return ((v == ErrVal) ? ErrVal : fabsl(v));
+}
+inline double ValOppose(double v)
+{
+  return ((v == ErrVal) ? ErrVal : -v);
+}
+inline double ValArcSinus(double v)
+{
+  return ((v == ErrVal || fabsl(v) > 1) ? ErrVal : asinl(v));
+}
+inline double ValArcCosinus(double v)
+{
+  return ((v == ErrVal || fabsl(v) > 1) ? ErrVal : acosl(v));
+}
+inline double ValArcTangente(double v)
+{
+  return ((v == ErrVal) ? ErrVal : atanl(v));
+}
+inline double ValLogarithme(double v)
+{
+  return ((v == ErrVal || v <= 0) ? ErrVal : logl(v));
+}
+inline double ValExponentielle(double v)
+{
+  return ((v == ErrVal || v > DBL_MAX_EXP) ? ErrVal : expl(v));
+}
+inline double ValSinus(double v)
+{
+  return ((v == ErrVal || fabsl(v) > inveps) ? ErrVal : sinl(v));
+}
+inline double ValTangente(double v)
+{
+  return ((v == ErrVal || fabsl(v) > inveps) ? ErrVal : tanl(v));
+}
+inline double ValCosinus(double v)
+{
+  return ((v == ErrVal || fabsl(v) > inveps) ? ErrVal : cosl(v));
+}
+inline double ValRacine(double v)
+{
+  return ((v == ErrVal || v > sqrtmaxfloat || v < 0) ? ErrVal : sqrtl(v));
+}
+inline double ValFonctionError(double)
+{
+  return ErrVal;
+}
+
+// C++ source of the functions above, used by ROperation::CCode (has to be kept in sync)
+const char* CCodeDefinitions()
+{
+  return R"code(#include <cfloat>
+#include <cmath>
+static const double ErrVal = DBL_MAX;
+static const double sqrtmaxfloat = std::sqrt(DBL_MAX);
+static const double sqrtminfloat = std::sqrt(DBL_MIN);
+static const double inveps = .1 / DBL_EPSILON;
+static inline double ValAddition(double v1, double v2)
+{
+  if (v2 == ErrVal || std::fabs(v2) > sqrtmaxfloat || v1 == ErrVal || std::fabs(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 + v2;
+}
+static inline double ValSoustraction(double v1, double v2)
+{
+  if (v2 == ErrVal || std::fabs(v2) > sqrtmaxfloat || v1 == ErrVal || std::fabs(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 - v2;
+}
+static inline double ValMultiplication(double v1, double v2)
+{
+  if (std::fabs(v2) < sqrtminfloat)
+    return 0;
+  if (v2 == ErrVal || std::fabs(v2) > sqrtmaxfloat)
+    return ErrVal;
+  if (std::fabs(v1) < sqrtminfloat)
+    return 0;
+  if (v1 == ErrVal || std::fabs(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 * v2;
+}
+static inline double ValDivision(double v1, double v2)
+{
+  if (std::fabs(v2) < sqrtminfloat || v2 == ErrVal || std::fabs(v2) > sqrtmaxfloat)
+    return ErrVal;
+  if (std::fabs(v1) < sqrtminfloat)
+    v1 = 0;
+  else if (v1 == ErrVal || std::fabs(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 / v2;
+}
+static inline double ValPuissance(double v1, double v2)
+{
+  if (!v1)
+    return 0;
+  if (v2 == ErrVal || v1 == ErrVal || std::fabs(v2 * std::log(std::fabs(v1))) > DBL_MAX_EXP)
+    return ErrVal;
+  return ((v1 > 0 || !std::fmod(v2, 1)) ? std::pow(v1, v2) : ErrVal);
+}
+static inline double ValRacineN(double v1, double v2)
+{
+  if (v1 == ErrVal || v2 == ErrVal || !v1 || v2 * std::log(std::fabs(v1)) < DBL_MIN_EXP)
+    return ErrVal;
+  if (v2 >= 0)
+    return std::pow(v2, 1 / v1);
+  return ((std::fabs(std::fmod(v1, 2)) == 1) ? -std::pow(-v2, 1 / v1) : ErrVal);
+}
+static inline double ValPuiss10(double v1, double v2)
+{
+  if (std::fabs(v2) < sqrtminfloat)
+    return 0;
+  if (v2 == ErrVal || std::fabs(v2) > DBL_MAX_10_EXP)
+    return ErrVal;
+  if (std::fabs(v1) < sqrtminfloat)
+    v1 = 0;
+  else if (v1 == ErrVal || std::fabs(v1) > sqrtmaxfloat)
+    return ErrVal;
+  return v1 * std::pow(10, v2);
+}
+static inline double ValArcTangente2(double v1, double v2)
+{
+  if (v2 == ErrVal || std::fabs(v2) > inveps || v1 == ErrVal || std::fabs(v1) > inveps)
+    return ErrVal;
+  return (v1 || v2 ? std::atan2(v1, v2) : ErrVal);
+}
+static inline double ValAbsolu(double v) { return ((v == ErrVal) ? ErrVal : std::fabs(v)); }
+static inline double ValOppose(double v) { return ((v == ErrVal) ? ErrVal : -v); }
+static inline double ValArcSinus(double v) { return ((v == ErrVal || std::fabs(v) > 1) ? ErrVal : std::asin(v)); }
+static inline double ValArcCosinus(double v) { return ((v == ErrVal || std::fabs(v) > 1) ? ErrVal : std::acos(v)); }
+static inline double ValArcTangente(double v) { return ((v == ErrVal) ? ErrVal : std::atan(v)); }
+static inline double ValLogarithme(double v) { return ((v == ErrVal || v <= 0) ? ErrVal : std::log(v)); }
+static inline double ValExponentielle(double v) { return ((v == ErrVal || v > DBL_MAX_EXP) ? ErrVal : std::exp(v)); }
+static inline double ValSinus(double v) { return ((v == ErrVal || std::fabs(v) > inveps) ? ErrVal : std::sin(v)); }
+static inline double ValTangente(double v) { return ((v == ErrVal || std::fabs(v) > inveps) ? ErrVal : std::tan(v)); }
+static inline double ValCosinus(double v) { return ((v == ErrVal || std::fabs(v) > inveps) ? ErrVal : std::cos(v)); }
+static inline double ValRacine(double v) { return ((v == ErrVal || v > sqrtmaxfloat || v < 0) ? ErrVal : std::sqrt(v)); }
+static inline double ValFonctionError(double) { return ErrVal; }
+)code";
+}
+
+// Scalar kernels, p points to the top of the stack
+
+template <double((*f)(double, double))>
+inline void Binary(double*& p)
+{
+  double v2 = *p--;
+  *p = f(*p, v2);
+}
+template <double((*f)(double))>
+inline void Unary(double*& p)
+{
+  *p = f(*p);
+}
+
 void Addition(double*& p)
 {
-  if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (*(--p) == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *p = ErrVal;
-    return;
-  };
-  *p += (*(p + 1));
+  Binary<&ValAddition>(p);
 }
 void Soustraction(double*& p)
 {
-  if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (*(--p) == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *p = ErrVal;
-    return;
-  };
-  *p -= (*(p + 1));
+  Binary<&ValSoustraction>(p);
 }
 void Multiplication(double*& p)
 {
-  if (fabsl(*p) < sqrtminfloat) {
-    *--p = 0;
-    return;
-  };
-  if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (fabsl(*(--p)) < sqrtminfloat) {
-    *p = 0;
-    return;
-  };
-  if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *p = ErrVal;
-    return;
-  };
-  *p *= (*(p + 1));
+  Binary<&ValMultiplication>(p);
 }
 void Division(double*& p)
 {
-  if (fabsl(*p) < sqrtminfloat || *p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (fabsl(*(--p)) < sqrtminfloat)
-    *p = 0;
-  else if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *p = ErrVal;
-    return;
-  };
-  *p /= (*(p + 1));
+  Binary<&ValDivision>(p);
 }
 void Puissance(double*& p)
 {
-  double v2 = *p--, v1 = *p;
-  if (!v1) {
-    *p = 0;
-    return;
-  };
-  if (v2 == ErrVal || v1 == ErrVal || fabsl(v2 * logl(fabsl(v1))) > DBL_MAX_EXP) {
-    *p = ErrVal;
-    return;
-  };
-  *p = ((v1 > 0 || !fmodl(v2, 1)) ? powl(v1, v2) : ErrVal);
+  Binary<&ValPuissance>(p);
 }
 void RacineN(double*& p)
 {
-  double v2 = *p--, v1 = *p;
-  if (v1 == ErrVal || v2 == ErrVal || !v1 || v2 * logl(fabsl(v1)) < DBL_MIN_EXP) {
-    *p = ErrVal;
-    return;
-  };
-  if (v2 >= 0) {
-    *p = powl(v2, 1 / v1);
-    return;
-  };
-  *p = ((fabsl(fmodl(v1, 2)) == 1) ? -powl(-v2, 1 / v1) : ErrVal);
+  Binary<&ValRacineN>(p);
 }
 void Puiss10(double*& p)
 {
-  if (fabsl(*p) < sqrtminfloat) {
-    *(--p) = 0;
-    return;
-  };
-  if (*p == ErrVal || fabsl(*p) > DBL_MAX_10_EXP) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (fabsl(*(--p)) < sqrtminfloat)
-    *p = 0;
-  else if (*p == ErrVal || fabsl(*p) > sqrtmaxfloat) {
-    *p = ErrVal;
-    return;
-  };
-  *p *= pow10l(*(p + 1));
+  Binary<&ValPuiss10>(p);
 }
 void ArcTangente2(double*& p)
 {
-  if (*p == ErrVal || fabsl(*p) > inveps) {
-    *(--p) = ErrVal;
-    return;
-  };
-  if (*(--p) == ErrVal || fabsl(*p) > inveps) {
-    *p = ErrVal;
-    return;
-  };
-  *p = (*p || *(p + 1) ? atan2(*p, *(p + 1)) : ErrVal);
+  Binary<&ValArcTangente2>(p);
 }
 void NextVal(double*&) {}
 void RFunc(double*&) {}
 void JuxtF(double*&) {}
 void Absolu(double*& p)
 {
-  *p = ((*p == ErrVal) ? ErrVal : fabsl(*p));
+  Unary<&ValAbsolu>(p);
 }
 void Oppose(double*& p)
 {
-  *p = ((*p == ErrVal) ? ErrVal : -*p);
+  Unary<&ValOppose>(p);
 }
 void ArcSinus(double*& p)
 {
-  *p = ((*p == ErrVal || fabsl(*p) > 1) ? ErrVal : asinl(*p));
+  Unary<&ValArcSinus>(p);
 }
 void ArcCosinus(double*& p)
 {
-  *p = ((*p == ErrVal || fabsl(*p) > 1) ? ErrVal : acosl(*p));
+  Unary<&ValArcCosinus>(p);
 }
 void ArcTangente(double*& p)
 {
-  *p = ((*p == ErrVal) ? ErrVal : atanl(*p));
+  Unary<&ValArcTangente>(p);
 }
 void Logarithme(double*& p)
 {
-  *p = ((*p == ErrVal || *p <= 0) ? ErrVal : logl(*p));
+  Unary<&ValLogarithme>(p);
 }
 void Exponentielle(double*& p)
 {
-  *p = ((*p == ErrVal || *p > DBL_MAX_EXP) ? ErrVal : expl(*p));
+  Unary<&ValExponentielle>(p);
 }
 void Sinus(double*& p)
 {
-  *p = ((*p == ErrVal || fabsl(*p) > inveps) ? ErrVal : sinl(*p));
+  Unary<&ValSinus>(p);
 }
 void Tangente(double*& p)
 {
-  *p = ((*p == ErrVal || fabsl(*p) > inveps) ? ErrVal : tanl(*p));
+  Unary<&ValTangente>(p);
 }
 void Cosinus(double*& p)
 {
-  *p = ((*p == ErrVal || fabsl(*p) > inveps) ? ErrVal : cosl(*p));
+  Unary<&ValCosinus>(p);
 }
 void Racine(double*& p)
 {
-  *p = ((*p == ErrVal || *p > sqrtmaxfloat || *p < 0) ? ErrVal : sqrtl(*p));
+  Unary<&ValRacine>(p);
 }
 void FonctionError(double*& p)
 {
-  *p = ErrVal;
+  Unary<&ValFonctionError>(p);
+}
+
+// Block kernels, the stack consists of blocks of n values and p points to the first value of the top block
+
+typedef void((*pfonclb)(double*&, int));
+
+template <double((*f)(double, double))>
+void BlockBinary(double*& p, int n)
+{
+  double* q = p - n;
+  for (int i = 0; i < n; i++)
+    q[i] = f(q[i], p[i]);
+  p = q;
+}
+template <double((*f)(double))>
+void BlockUnary(double*& p, int n)
+{
+  for (int i = 0; i < n; i++)
+    p[i] = f(p[i]);
+}
+void BlockJuxtF(double*&, int) {}
+
+pfonclb BlockInstr(pfoncld f) // Block kernel corresponding to a scalar kernel
+{
+  if (f == &Addition)
+    return &BlockBinary<&ValAddition>;
+  if (f == &Soustraction)
+    return &BlockBinary<&ValSoustraction>;
+  if (f == &Multiplication)
+    return &BlockBinary<&ValMultiplication>;
+  if (f == &Division)
+    return &BlockBinary<&ValDivision>;
+  if (f == &Puissance)
+    return &BlockBinary<&ValPuissance>;
+  if (f == &RacineN)
+    return &BlockBinary<&ValRacineN>;
+  if (f == &Puiss10)
+    return &BlockBinary<&ValPuiss10>;
+  if (f == &ArcTangente2)
+    return &BlockBinary<&ValArcTangente2>;
+  if (f == &JuxtF)
+    return &BlockJuxtF;
+  if (f == &Absolu)
+    return &BlockUnary<&ValAbsolu>;
+  if (f == &Oppose)
+    return &BlockUnary<&ValOppose>;
+  if (f == &ArcSinus)
+    return &BlockUnary<&ValArcSinus>;
+  if (f == &ArcCosinus)
+    return &BlockUnary<&ValArcCosinus>;
+  if (f == &ArcTangente)
+    return &BlockUnary<&ValArcTangente>;
+  if (f == &Logarithme)
+    return &BlockUnary<&ValLogarithme>;
+  if (f == &Exponentielle)
+    return &BlockUnary<&ValExponentielle>;
+  if (f == &Sinus)
+    return &BlockUnary<&ValSinus>;
+  if (f == &Tangente)
+    return &BlockUnary<&ValTangente>;
+  if (f == &Cosinus)
+    return &BlockUnary<&ValCosinus>;
+  if (f == &Racine)
+    return &BlockUnary<&ValRacine>;
+  return &BlockUnary<&ValFonctionError>;
+}
+
+// Vectorized block kernels: the value functions below contain no branches (selections are done with bit masks, the
+// domains are checked on the integer representation, which is monotone for non-negative doubles), so that the loops
+// over a block can be auto-vectorized (e.g. with -O3 -mavx2). The transcendental functions are the approximations of
+// the Cephes library and are accurate to a few ulp within the domains given below. A kernel falls back to its scalar
+// counterpart for the whole block as soon as a single value lies outside of its domain (e.g. ErrVal), which keeps
+// the semantics of the interpreter.
+
+inline double VecAsDouble(int64_t i)
+{
+  double d;
+  memcpy(&d, &i, sizeof(double));
+  return d;
+}
+inline int64_t VecAsInt(double d)
+{
+  int64_t i;
+  memcpy(&i, &d, sizeof(double));
+  return i;
+}
+inline int64_t VecAbsAsInt(double d)
+{
+  return VecAsInt(d) & 0x7fffffffffffffffLL;
+}
+inline double VecSelect(int64_t mask, double v1, double v2) // mask has to be 0 or -1
+{
+  return VecAsDouble((VecAsInt(v1) & mask) | (VecAsInt(v2) & ~mask));
+}
+
+const double vecshifter = 6755399441055744.0; // 1.5 * 2^52, adding it rounds to an integer stored in the low bits
+const int64_t vecsqrtmaxfloat = VecAsInt(sqrt(DBL_MAX));
+const int64_t vecsqrtminfloat = VecAsInt(sqrt(DBL_MIN));
+
+inline double VecAddition(double v1, double v2)
+{
+  return v1 + v2;
+}
+inline double VecSoustraction(double v1, double v2)
+{
+  return v1 - v2;
+}
+inline double VecMultiplication(double v1, double v2)
+{
+  const int64_t zero = -(int64_t)((VecAbsAsInt(v1) < vecsqrtminfloat) | (VecAbsAsInt(v2) < vecsqrtminfloat));
+  return VecAsDouble(VecAsInt(v1 * v2) & ~zero);
+}
+inline double VecDivision(double v1, double v2)
+{
+  const int64_t zero = -(int64_t)(VecAbsAsInt(v1) < vecsqrtminfloat);
+  return VecAsDouble(VecAsInt(v1) & ~zero) / v2;
+}
+inline double VecAbsolu(double v)
+{
+  return fabs(v);
+}
+inline double VecOppose(double v)
+{
+  return -v;
+}
+inline double VecArcTangente(double v)
+{
+  const double x = fabs(v);
+  const int64_t big = -(int64_t)(VecAsInt(x) > VecAsInt(2.41421356237309504880));
+  const int64_t mid = ~big & -(int64_t)(VecAsInt(x) > VecAsInt(0.66));
+  const double xr = VecSelect(big, -1. / x, VecSelect(mid, (x - 1.) / (x + 1.), x));
+  const double y0 = VecSelect(big,
+                              1.57079632679489661923 + 6.123233995736765886130E-17,
+                              VecSelect(mid, 0.78539816339744830962 + 0.5 * 6.123233995736765886130E-17, 0.));
+  const double z = xr * xr;
+  const double p = (((-8.750608600031904122785E-1 * z - 1.615753718733365076637E1) * z - 7.500855792314704667340E1) * z
+                    - 1.228866684490136173410E2)
+                       * z
+                   - 6.485021904942025371773E1;
+  const double q =
+      ((((z + 2.485846490142306297962E1) * z + 1.650270098316988542046E2) * z + 4.328810604912902668951E2) * z
+       + 4.853903996359136964868E2)
+          * z
+      + 1.945506571482613964425E2;
+  const double r = y0 + (xr * (z * p / q) + xr);
+  return VecAsDouble(VecAsInt(r) ^ (VecAsInt(v) & (int64_t)0x8000000000000000ULL));
+}
+inline double VecLogarithme(double v)
+{
+  const int64_t bits = VecAsInt(v);
+  int64_t mbits = (bits & 0x000fffffffffffffLL) | 0x3fe0000000000000LL; // mantissa in [0.5, 1)
+  const int64_t small = -(int64_t)(mbits < 0x3fe6a09e667f3bcdLL); // mantissa < sqrt(0.5), is doubled
+  mbits += small & 0x0010000000000000LL;
+  const double e = VecAsDouble(((bits >> 52) - (small & 1)) | 0x4330000000000000LL) - 4503599627370496. - 1022.;
+  const double x = VecAsDouble(mbits) - 1.;
+  const double z = x * x;
+  const double p = ((((1.01875663804580931796E-4 * x + 4.97494994976747001425E-1) * x + 4.70579119878881725854E0) * x
+                     + 1.44989225341610930846E1)
+                        * x
+                    + 1.79368678507819816313E1)
+                       * x
+                   + 7.70838733755885391666E0;
+  const double q = ((((x + 1.12873587189167450590E1) * x + 4.52279145837532221105E1) * x + 8.29875266912776603211E1) * x
+                    + 7.11544750618563894466E1)
+                       * x
+                   + 2.31251620126765340583E1;
+  double y = x * (z * p / q);
+  y = y - e * 2.121944400546905827679e-4;
+  y = y - 0.5 * z;
+  return (x + y) + e * 0.693359375;
+}
+inline double VecExponentielle(double v)
+{
+  const double kd = v * 1.4426950408889634073599 + vecshifter;
+  const double k = kd - vecshifter;
+  double x = v - k * 6.93145751953125E-1;
+  x = x - k * 1.42860682030941723212E-6;
+  const double xx = x * x;
+  const double px =
+      x * ((1.26177193074810590878E-4 * xx + 3.02994407707441961300E-2) * xx + 9.99999999999999999910E-1);
+  const double qx =
+      ((3.00198505138664455042E-6 * xx + 2.52448340349684104192E-3) * xx + 2.27265548208155028766E-1) * xx
+      + 2.00000000000000000009E0;
+  const double y = 1. + 2. * (px / (qx - px));
+  return y * VecAsDouble((VecAsInt(kd) + 1023) << 52);
+}
+inline double VecSinCos(double v, const int64_t cosine) // cosine has to be 0 or -1
+{
+  const double x = fabs(v);
+  const double yd = x * 1.27323954473516268615 + vecshifter; // x / (pi / 4), rounded to nearest
+  double y = yd - vecshifter;
+  int64_t j = VecAsInt(yd);
+  const int64_t up = -(int64_t)(VecAsInt(y) > VecAsInt(x * 1.27323954473516268615));
+  y = y - VecAsDouble(up & VecAsInt(1.));
+  j = j + up;
+  const int64_t odd = j & 1;
+  j = (j + odd) & 7;
+  y = y + VecAsDouble(-odd & VecAsInt(1.));
+  const int64_t high = j >> 2;
+  j = j & 3;
+  int64_t flip = high ^ (cosine & (j >> 1));
+  flip = flip ^ (~cosine & (int64_t)((uint64_t)VecAsInt(v) >> 63));
+  // extended precision modular arithmetic
+  const double z =
+      ((x - y * 7.85398125648498535156E-1) - y * 3.77489470793079817668E-8) - y * 2.69515142907905952645E-15;
+  const double zz = z * z;
+  const double c = 1. - 0.5 * zz
+                   + zz * zz
+                         * (((((-1.13585365213876817300E-11 * zz + 2.08757008419747316778E-9) * zz
+                               - 2.75573141792967388112E-7)
+                                  * zz
+                              + 2.48015872888517045348E-5)
+                                 * zz
+                             - 1.38888888888730564116E-3)
+                                * zz
+                            + 4.16666666666665929218E-2);
+  const double s = z
+                   + z
+                         * (zz
+                            * (((((1.58962301576546568060E-10 * zz - 2.50507477628578072866E-8) * zz
+                                  + 2.75573136213857245213E-6)
+                                     * zz
+                                 - 1.98412698295895385996E-4)
+                                    * zz
+                                + 8.33333333332211858878E-3)
+                                   * zz
+                               - 1.66666666666666307295E-1));
+  const int64_t usecos = -(((j ^ (j >> 1)) & 1) ^ (cosine & 1));
+  return VecAsDouble(VecAsInt(VecSelect(usecos, c, s)) ^ (flip << 63));
+}
+inline double VecSinus(double v)
+{
+  return VecSinCos(v, 0);
+}
+inline double VecCosinus(double v)
+{
+  return VecSinCos(v, -1);
+}
+inline double VecRacine(double v)
+{
+  return sqrt(v);
+}
+
+// Domains of the vectorized kernels, in which they coincide with the scalar ones (up to rounding)
+
+inline bool VecBounded(double v) // |v| <= sqrtmaxfloat, excludes ErrVal and NaN
+{
+  return VecAbsAsInt(v) <= vecsqrtmaxfloat;
+}
+inline bool VecBoundedDivisor(double v)
+{
+  return (VecAbsAsInt(v) <= vecsqrtmaxfloat) & (VecAbsAsInt(v) >= vecsqrtminfloat);
+}
+inline bool VecNotErrVal(double v)
+{
+  return VecAsInt(v) != VecAsInt(ErrVal);
+}
+inline bool VecAnyValue(double)
+{
+  return true;
+}
+inline bool VecFinite(double v) // excludes +-ErrVal, infinities and NaN
+{
+  return VecAbsAsInt(v) < VecAsInt(ErrVal);
+}
+inline bool VecLogarithmeDomain(double v) // normal positive numbers
+{
+  return (VecAsInt(v) >= VecAsInt(DBL_MIN)) & (VecAsInt(v) < VecAsInt(ErrVal));
+}
+inline bool VecExponentielleDomain(double v) // results are normal numbers
+{
+  return VecAbsAsInt(v) <= VecAsInt(708.);
 }
+inline bool VecSinCosDomain(double v) // the argument reduction is accurate
+{
+  return VecAbsAsInt(v) <= VecAsInt(1e8);
+}
+inline bool VecRacineDomain(double v) // non-negative, -0 is left to the scalar kernel
+{
+  return (VecAsInt(v) >= 0) & (VecAsInt(v) <= vecsqrtmaxfloat);
+}
+
+template <bool((*d)(double)), double((*vf)(double, double)), double((*f)(double, double))>
+void VecBlockBinary(double*& p, int n)
+{
+  double* q = p - n;
+  int inside = 1;
+  for (int i = 0; i < n; i++)
+    inside &= d(q[i]) & d(p[i]);
+  if (inside) {
+    for (int i = 0; i < n; i++)
+      q[i] = vf(q[i], p[i]);
+    p = q;
+  } else
+    BlockBinary<f>(p, n);
+}
+template <bool((*d)(double)), double((*vf)(double)), double((*f)(double))>
+void VecBlockUnary(double*& p, int n)
+{
+  int inside = 1;
+  for (int i = 0; i < n; i++)
+    inside &= d(p[i]);
+  if (inside)
+    for (int i = 0; i < n; i++)
+      p[i] = vf(p[i]);
+  else
+    BlockUnary<f>(p, n);
+}
+void VecBlockDivision(double*& p, int n) // the dividend and the divisor have different domains
+{
+  double* q = p - n;
+  int inside = 1;
+  for (int i = 0; i < n; i++)
+    inside &= VecBounded(q[i]) & VecBoundedDivisor(p[i]);
+  if (inside) {
+    for (int i = 0; i < n; i++)
+      q[i] = VecDivision(q[i], p[i]);
+    p = q;
+  } else
+    BlockBinary<&ValDivision>(p, n);
+}
+
+pfonclb VecBlockInstr(pfoncld f) // Vectorized block kernel corresponding to a scalar kernel
+{
+  if (f == &Addition)
+    return &VecBlockBinary<&VecBounded, &VecAddition, &ValAddition>;
+  if (f == &Soustraction)
+    return &VecBlockBinary<&VecBounded, &VecSoustraction, &ValSoustraction>;
+  if (f == &Multiplication)
+    return &VecBlockBinary<&VecBounded, &VecMultiplication, &ValMultiplication>;
+  if (f == &Division)
+    return &VecBlockDivision;
+  if (f == &Absolu)
+    return &VecBlockUnary<&VecAnyValue, &VecAbsolu, &ValAbsolu>;
+  if (f == &Oppose)
+    return &VecBlockUnary<&VecNotErrVal, &VecOppose, &ValOppose>;
+  if (f == &ArcTangente)
+    return &VecBlockUnary<&VecFinite, &VecArcTangente, &ValArcTangente>;
+  if (f == &Logarithme)
+    return &VecBlockUnary<&VecLogarithmeDomain, &VecLogarithme, &ValLogarithme>;
+  if (f == &Exponentielle)
+    return &VecBlockUnary<&VecExponentielleDomain, &VecExponentielle, &ValExponentielle>;
+  if (f == &Sinus)
+    return &VecBlockUnary<&VecSinCosDomain, &VecSinus, &ValSinus>;
+  if (f == &Cosinus)
+    return &VecBlockUnary<&VecSinCosDomain, &VecCosinus, &ValCosinus>;
+  if (f == &Racine)
+    return &VecBlockUnary<&VecRacineDomain, &VecRacine, &ValRacine>;
+  return BlockInstr(f);
+}
+
 inline void ApplyRFunc(PRFunction rf, double*& p)
 {
   p -= rf->nvars - 1;
@@ -1990,6 +2888,91 @@ double ROperation::Val() const
   return *p3;
 }
 
+double ROperation::Val(const double* vars, int nvars, const double* args, double* stack) const
+{
+  pfoncld* p1 = pinstr;
+  double** p2 = pvals;
+  double* p3 = stack - 1;
+  PRFunction* p4 = pfuncpile;
+  const double* v;
+  for (; *p1 != NULL; p1++)
+    if (*p1 == &NextVal) {
+      v = *(p2++);
+      *(++p3) = ((v >= vars && v < vars + nvars) ? args[v - vars] : *v);
+    } else if (*p1 == &RFunc)
+      ApplyRFunc(*(p4++), p3);
+    else
+      (**p1)(p3);
+  return *p3;
+}
+
+void ROperation::Val(
+    const double* vars, int nvars, int npoints, const double* args, double* results, double* stack) const
+{
+  BlockVal(vars, nvars, npoints, args, results, stack, false);
+}
+
+void ROperation::VecVal(
+    const double* vars, int nvars, int npoints, const double* args, double* results, double* stack) const
+{
+  BlockVal(vars, nvars, npoints, args, results, stack, true);
+}
+
+void ROperation::BlockVal(const double* vars,
+                          int nvars,
+                          int npoints,
+                          const double* args,
+                          double* results,
+                          double* stack,
+                          bool vectorized) const
+{
+  pfoncld* p1 = pinstr;
+  double** p2 = pvals;
+  double* p3 = stack - npoints;
+  PRFunction* p4 = pfuncpile;
+  const double* v;
+  double* buf;
+  int i, j;
+  for (; *p1 != NULL; p1++)
+    if (*p1 == &NextVal) {
+      v = *(p2++);
+      p3 += npoints;
+      if (v >= vars && v < vars + nvars)
+        memcpy(p3, args + (v - vars) * npoints, npoints * sizeof(double));
+      else
+        for (i = 0; i < npoints; i++)
+          p3[i] = *v;
+    } else if (*p1 == &RFunc) { // Functions are applied point by point
+      p3 -= ((*p4)->nvars - 1) * npoints;
+      buf = new double[(*p4)->nvars];
+      for (i = 0; i < npoints; i++) {
+        for (j = 0; j < (*p4)->nvars; j++)
+          buf[j] = p3[j * npoints + i];
+        p3[i] = (*p4)->Val(buf);
+      }
+      delete[] buf;
+      p4++;
+    } else
+      (*(vectorized ? VecBlockInstr(*p1) : BlockInstr(*p1)))(p3, npoints);
+  memcpy(results, p3, npoints * sizeof(double));
+}
+
+int ROperation::StackSize() const
+{
+  int n = 0;
+  for (double* pp = ppile; *pp != ErrVal; pp++)
+    n++;
+  return n;
+}
+
+int ROperation::NInstructions() const
+{
+  int n = 0;
+  for (pfoncld* pf = pinstr; *pf != NULL; pf++)
+    n++;
+  return n;
+}
+
 void BCDouble(pfoncld*& pf,
               pfoncld* pf1,
               pfoncld* pf2,
@@ -115,6 +115,8 @@ class ROperation
   mutable signed char containfuncflag;
   void BuildCode();
   void Destroy();
+  void BlockVal(const double*, int, int, const double*, double*, double*, bool) const;
+  void SimplifyNode();
 
 public:
   ROperator op;
@@ -130,6 +132,20 @@ public:
   ROperation(const char* sp, int nvarp = 0, PRVar* ppvarp = NULL, int nfuncp = 0, PRFunction* ppfuncp = NULL);
   ~ROperation();
   double Val() const;
+  // Reentrant variant of Val(): every variable whose value is stored in vars[0], ..., vars[nvars - 1] is read from
+  // args[0], ..., args[nvars - 1] instead, the caller provides a stack of at least StackSize() entries.
+  // Does not modify any shared state unless the operation contains functions.
+  double Val(const double* vars, int nvars, const double* args, double* stack) const;
+  // Block variant of the reentrant Val() for npoints points at once: each instruction is applied to all points before
+  // the next one is processed. The values of the k-th variable are args[k * npoints], ..., args[(k + 1) * npoints - 1],
+  // the stack has to hold at least StackSize() * npoints entries, results has to hold npoints entries.
+  void Val(const double* vars, int nvars, int npoints, const double* args, double* results, double* stack) const;
+  // Same as the block Val(), but uses kernels written for auto-vectorization wherever all values of a block lie in the
+  // domain of the kernel (and the scalar ones otherwise). The results coincide with the ones of Val() up to a few ulp.
+  void VecVal(const double* vars, int nvars, int npoints, const double* args, double* results, double* stack) const;
+  int StackSize() const;
+  // Number of instructions executed by Val(), a measure of the cost of an evaluation
+  int NInstructions() const;
   signed char ContainVar(const RVar&) const;
   signed char ContainFunc(const RFunction&) const;
   signed char ContainFuncNoRec(const RFunction&) const; // No recursive test on subfunctions
@@ -161,7 +177,15 @@ public:
   friend ROperation ApplyOperator(int, ROperation**, ROperation (*)(const ROperation&, const ROperation&));
   ROperation Diff(const RVar&) const; //  Differentiate w.r.t a variable
   char* Expr() const;
+  // C++ expression computing the same value as Val(vars, nvars, args, stack) for args named x, up to rounding (using
+  // the functions defined in CCodeDefinitions()), NULL if the operation contains functions or other variables
+  char* CCode(const double* vars, int nvars) const;
   ROperation Substitute(const RVar&, const ROperation&) const;
+  // Constant folding and simplifications like x+0 -> x, x*1 -> x, --x -> x or x^2 -> x*x, which do not change the value
+  // (up to rounding) wherever it is not ErrVal
+  ROperation Simplify() const;
+  // Replaces every occurrence of the subexpression target by rop, returns the number of occurrences
+  int Replace(const ROperation& target, const ROperation& rop);
 };
 
 class RFunction
@@ -189,6 +213,22 @@ public:
   ROperation operator()(const ROperation&);
 };
 
+const char* CCodeDefinitions();
+
+// Common subexpression elimination: replaces the largest subexpression occurring more than once in *pops[0], ...,
+// *pops[nops - 1] (and in the subexpressions replaced before) by a new variable, until there is none left or maxtemps
+// variables have been used. The k-th variable ptempvars[k] stores its value in tempvals[k] and the subexpression it
+// stands for is *ptemps[k], which only depends on the variables k + 1, ... (both are allocated with new). Returns the
+// number of variables used.
+int EliminateCommonSubexpressions(
+    int nops, ROperation** pops, int maxtemps, double* tempvals, PRVar* ptempvars, ROperation** ptemps);
+
+// Affine decomposition w.r.t. the variables *ppvars[0], ..., *ppvars[nvars - 1]: if rop is affine in these variables,
+// i.e. rop = pcomps[0] + *ppvars[0] * pcomps[1] + ... + *ppvars[nvars - 1] * pcomps[nvars] with none of the pcomps[k]
+// containing any of the variables, stores the (simplified) components in pcomps[0], ..., pcomps[nvars] and returns 1.
+// Returns 0 otherwise (also if affinity cannot be detected symbolically, e.g. for t*t/t).
+signed char AffineDecomposition(const ROperation& rop, int nvars, const PRVar* ppvars, ROperation* pcomps);
+
 char* MidStr(const char* s, int i1, int i2);
 char* CopyStr(const char* s);
 char* InsStr(const char* s, int n, char c);
@@ -13,12 +13,16 @@
 #ifndef DUNE_XT_FUNCTIONS_EXPRESSION_PARAMETRIC_HH
 #define DUNE_XT_FUNCTIONS_EXPRESSION_PARAMETRIC_HH
 
+#include <array>
 #include <limits>
 
 #include <dune/xt/common/parameter.hh>
+#include "dune/xt/functions/affinely-decomposed.hh"
+#include "dune/xt/functions/exceptions.hh"
 #include "dune/xt/functions/interfaces/function.hh"
 
 #include "base.hh"
+#include "default.hh"
 
 namespace Dune {
 namespace XT {
@@ -40,6 +44,7 @@ template <size_t d, size_t r, class R>
 class ParametricExpressionFunction<d, r, 1, R> : public FunctionInterface<d, r, 1, R>
 {
   using BaseType = FunctionInterface<d, r, 1, R>;
+  using ThisType = ParametricExpressionFunction<d, r, 1, R>;
   using typename BaseType::D;
   using ActualFunctionType = DynamicMathExpressionBase<D, R, r>;
 
@@ -50,6 +55,77 @@ public:
   using typename BaseType::DomainType;
   using typename BaseType::RangeReturnType;
 
+  /**
+   * \brief This function with a fixed parameter, see with_parameter.
+   *
+   *        The values of the parameter are stored in the variable slots of the expressions once, so evaluations neither
+   *        parse the parameter nor allocate any memory. Can also be created directly, if the type of the function is
+   *        known:
+\code
+const typename FunctionType::ParameterBoundExpressionFunction bound_function(function, param);
+\endcode
+   */
+  class ParameterBoundExpressionFunction : public FunctionInterface<d, r, 1, R>
+  {
+    using InterfaceType = FunctionInterface<d, r, 1, R>;
+
+  public:
+    using typename InterfaceType::DerivativeRangeReturnType;
+    using typename InterfaceType::DomainType;
+    using typename InterfaceType::RangeReturnType;
+
+    ParameterBoundExpressionFunction(const ThisType& function, const Common::Parameter& param)
+      : function_(function.function_)
+      , order_(function.order_)
+      , name_(function.name_)
+      , param_(function.parse_and_check_parameter(param))
+      , num_parameter_variables_(function.num_parameter_variables_)
+    {
+      size_t II = 0;
+      for (const auto& key : function.param_type_.keys())
+        for (const auto& value : param_.get(key))
+          args_[II++] = value;
+    }
+
+    std::string name() const override final
+    {
+      return name_;
+    }
+
+    int order(const Common::Parameter& /*param*/ = {}) const override final
+    {
+      return static_cast<int>(order_);
+    }
+
+    RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
+                             const Common::Parameter& /*param*/ = {}) const override final
+    {
+      double args[ActualFunctionType::maxDimDomain];
+      for (size_t ii = 0; ii < num_parameter_variables_; ++ii)
+        args[ii] = args_[ii];
+      for (size_t ii = 0; ii < domain_dim; ++ii)
+        args[num_parameter_variables_ + ii] = point_in_global_coordinates[ii];
+      RangeReturnType ret;
+      function_->evaluate(args, ret);
+      check_value(*function_, point_in_global_coordinates, param_, ret);
+      return ret;
+    }
+
+    DerivativeRangeReturnType jacobian(const DomainType& /*point_in_global_coordinates*/,
+                                       const Common::Parameter& /*param*/ = {}) const override final
+    {
+      DUNE_THROW(NotImplemented, "Not yet, at least...");
+    }
+
+  private:
+    const std::shared_ptr<const ActualFunctionType> function_;
+    const size_t order_;
+    const std::string name_;
+    const Common::Parameter param_;
+    const size_t num_parameter_variables_;
+    std::array<double, ActualFunctionType::maxDimDomain> args_;
+  }; // class ParameterBoundExpressionFunction
+
   static std::string static_id()
   {
     return BaseType::static_id() + ".parametricexpression";
@@ -60,7 +136,8 @@ public:
                                const Common::FieldVector<std::string, r>& expressions,
                                const size_t ord = 0,
                                const std::string nm = static_id())
-    : order_(ord)
+    : variable_(variable)
+    , order_(ord)
     , name_(nm)
     , param_type_(param_type)
     , num_parameter_variables_(0)
@@ -109,19 +186,16 @@ public:
     return param_type_;
   }
 
+  /**
+   * \note For many evaluations with the same parameter, use with_parameter instead, which parses the parameter only
+   *       once.
+   */
   RangeReturnType evaluate(const DomainType& point_in_global_coordinates,
                            const Common::Parameter& param = {}) const override final
   {
     RangeReturnType ret(0.);
-    Common::Parameter parsed_param;
-    if (!param_type_.empty()) {
-      parsed_param = this->parse_parameter(param);
-      if (parsed_param.type() != param_type_)
-        DUNE_THROW(Common::Exceptions::parameter_error,
-                   "parameter_type(): " << param_type_ << "\n   "
-                                        << "param.type(): " << param.type());
-    }
-    DynamicVector<D> args(num_parameter_variables_ + domain_dim);
+    const Common::Parameter parsed_param = parse_and_check_parameter(param);
+    double args[ActualFunctionType::maxDimDomain];
     size_t II = 0;
     for (const auto& key : param_type_.keys()) {
       for (const auto& value : parsed_param.get(key)) {
@@ -134,9 +208,84 @@ public:
       ++II;
     }
     function_->evaluate(args, ret);
+    check_value(*function_, point_in_global_coordinates, param, ret);
+    return ret;
+  } // ... evaluate(...)
 
-#ifndef NDEBUG
-#  ifndef DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS
+  DerivativeRangeReturnType jacobian(const DomainType& /*point_in_global_coordinates*/,
+                                     const Common::Parameter& /*param*/ = {}) const override final
+  {
+    DUNE_THROW(NotImplemented, "Not yet, at least...");
+  }
+
+  std::unique_ptr<BaseType> with_parameter(const Common::Parameter& param) const override final
+  {
+    return std::make_unique<ParameterBoundExpressionFunction>(*this, param);
+  }
+
+  /**
+   * \brief Returns the decomposition a(x; mu) = a_0(x) + sum_k mu_k a_k(x) of this function, if its expressions are
+   *        affine in the parameter, see AffinelyDecomposedFunction.
+   *
+   *        Here, mu_1, mu_2, ... are all entries of the parameter (in the order of the keys of parameter_type()). The
+   *        components are obtained symbolically (see AffineDecomposition) as ExpressionFunctions of the same order as
+   *        this function (with symbolic jacobians), components which vanish identically are left out.
+   */
+  AffinelyDecomposedFunction<d, r, 1, R> affine_decomposition() const
+  {
+    std::vector<std::vector<std::string>> component_expressions;
+    DUNE_THROW_IF(!function_->affine_decomposition(num_parameter_variables_, component_expressions),
+                  Exceptions::wrong_input_given,
+                  "The expressions of this function are not affine in its parameter!\n   "
+                      << "variables: " << function_->variables() << "\n   "
+                      << "expressions: " << function_->expressions());
+    using ComponentType = ExpressionFunction<d, r, 1, R>;
+    const auto backend = ComponentType::defaults().template get<std::string>("backend");
+    AffinelyDecomposedFunction<d, r, 1, R> decomposition(param_type_, name_ + "_affinely_decomposed");
+    // the coefficient of the first component is 1, the one of each further component an entry of the parameter
+    std::vector<typename AffinelyDecomposedFunction<d, r, 1, R>::CoefficientType> coefficients(
+        1, [](const Common::Parameter& /*param*/) { return R(1); });
+    for (const auto& key : param_type_.keys())
+      for (size_t ii = 0; ii < param_type_.get(key); ++ii)
+        coefficients.emplace_back([key, ii](const Common::Parameter& param) { return R(param.get(key)[ii]); });
+    for (size_t kk = 0; kk < component_expressions.size(); ++kk) {
+      Common::FieldVector<std::string, r> expressions;
+      bool vanishes = true;
+      for (size_t rr = 0; rr < r; ++rr) {
+        expressions[rr] = component_expressions[kk][rr];
+        vanishes = vanishes && (expressions[rr] == "0");
+      }
+      if (!vanishes)
+        decomposition.add(new ComponentType(variable_,
+                                            expressions,
+                                            order_,
+                                            name_ + "_component_" + Common::to_string(kk),
+                                            backend,
+                                            /*derive_gradients=*/true),
+                          coefficients[kk]);
+    }
+    return decomposition;
+  } // ... affine_decomposition(...)
+
+private:
+  Common::Parameter parse_and_check_parameter(const Common::Parameter& param) const
+  {
+    if (param_type_.empty())
+      return Common::Parameter();
+    auto parsed_param = this->parse_parameter(param);
+    if (parsed_param.type() != param_type_)
+      DUNE_THROW(Common::Exceptions::parameter_error,
+                 "parameter_type(): " << param_type_ << "\n   "
+                                      << "param.type(): " << param.type());
+    return parsed_param;
+  } // ... parse_and_check_parameter(...)
+
+#if !defined(NDEBUG) && !defined(DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS)
+  static void check_value(const ActualFunctionType& function,
+                          const DomainType& point_in_global_coordinates,
+                          const Common::Parameter& param,
+                          const RangeReturnType& ret)
+  {
     bool failure = false;
     std::string error_type;
     for (size_t rr = 0; rr < range_dim; ++rr) {
@@ -154,26 +303,24 @@ public:
         DUNE_THROW(Common::Exceptions::internal_error,
                    "evaluating this function yielded:     "
                        << error_type << "\n   "
-                       << "The variables of this function are:   " << function_->variables() << "\n   "
-                       << "The expressions of this function are: " << function_->expressions() << "\n   "
+                       << "The variables of this function are:   " << function.variables() << "\n   "
+                       << "The expressions of this function are: " << function.expressions() << "\n   "
                        << "You evaluated it with            point_in_global_coordinates : "
                        << point_in_global_coordinates << "\n   "
                        << "                                 param : " << param << "\n   "
                        << "The result was:                       " << ret[rr] << "\n\n"
                        << "You can disable this check by defining DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS\n");
     }
-#  endif // DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS
-#endif // NDEBUG
-    return ret;
-  } // ... evaluate(...)
-
-  DerivativeRangeReturnType jacobian(const DomainType& /*point_in_global_coordinates*/,
-                                     const Common::Parameter& /*param*/ = {}) const override final
-  {
-    DUNE_THROW(NotImplemented, "Not yet, at least...");
-  }
+  } // ... check_value(...)
+#else // !defined(NDEBUG) && !defined(DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS)
+  static void check_value(const ActualFunctionType& /*function*/,
+                          const DomainType& /*point_in_global_coordinates*/,
+                          const Common::Parameter& /*param*/,
+                          const RangeReturnType& /*ret*/)
+  {}
+#endif // !defined(NDEBUG) && !defined(DUNE_XT_FUNCTIONS_EXPRESSION_DISABLE_CHECKS)
 
-private:
+  std::string variable_;
   size_t order_;
   std::string name_;
   Common::ParameterType param_type_;
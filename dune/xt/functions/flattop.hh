@@ -48,6 +48,7 @@ public:
   using RangeFieldType = typename BaseType::RangeFieldType;
   using DomainType = typename BaseType::DomainType;
   using RangeReturnType = typename BaseType::RangeReturnType;
+  using DerivativeRangeReturnType = typename BaseType::DerivativeRangeReturnType;
 
   static const size_t domain_dim = BaseType::domain_dim;
   static const size_t range_dim = BaseType::range_dim;
@@ -131,6 +132,55 @@ public:
     return ret;
   } // ... evaluate(...)
 
+  DerivativeRangeReturnType jacobian(const DomainType& point_in_reference_element,
+                                     const Common::Parameter& param = {}) const override final
+  {
+    RangeReturnType value;
+    DerivativeRangeReturnType ret;
+    evaluate_with_jacobian(point_in_reference_element, value, ret, param);
+    return ret;
+  }
+
+  /**
+   * \brief Computes the value and the jacobian from the same one-dimensional factors (and their derivatives).
+   */
+  void evaluate_with_jacobian(const DomainType& point_in_reference_element,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& /*param*/ = {}) const override final
+  {
+    DomainType factors(1.);
+    DomainType derivatives(0.);
+    for (size_t dd = 0; dd < domain_dim; ++dd) {
+      const auto& left = lower_left_[dd];
+      const auto& right = upper_right_[dd];
+      const auto& point = point_in_reference_element[dd];
+      const auto& delta = boundary_layer_[dd];
+      if (point < left - delta || !(point < right + delta)) {
+        // outside
+        value = RangeReturnType(0.);
+        jacobian = DerivativeRangeReturnType(0.);
+        return;
+      } else if (point < left + delta) {
+        // left boundary layer
+        factors[dd] = phi_left((point - (left + delta)) / (2.0 * delta));
+        derivatives[dd] = dphi_left((point - (left + delta)) / (2.0 * delta)) / (2.0 * delta);
+      } else if (!(point < right - delta)) {
+        // right boundary layer
+        factors[dd] = phi_right((point - (right - delta)) / (2.0 * delta));
+        derivatives[dd] = dphi_right((point - (right - delta)) / (2.0 * delta)) / (2.0 * delta);
+      }
+    }
+    value = value_;
+    for (size_t dd = 0; dd < domain_dim; ++dd) {
+      value[0] *= factors[dd];
+      jacobian[0][dd] = value_[0] * derivatives[dd];
+      for (size_t ii = 0; ii < domain_dim; ++ii)
+        if (ii != dd)
+          jacobian[0][dd] *= factors[ii];
+    }
+  } // ... evaluate_with_jacobian(...)
+
 private:
   void check_input() const
   {
@@ -171,6 +221,22 @@ private:
       return std::pow(1.0 - point, 2) * (1.0 + 2.0 * point);
   } // ... phi_right(...)
 
+  RangeFieldType dphi_left(const RangeFieldType& point) const
+  {
+    if (point < -1.0 || point > 0.0)
+      return 0.0;
+    else
+      return -6.0 * point * (1.0 + point);
+  } // ... dphi_left(...)
+
+  RangeFieldType dphi_right(const RangeFieldType& point) const
+  {
+    if (point < 0.0 || point > 1.0)
+      return 0.0;
+    else
+      return -6.0 * point * (1.0 - point);
+  } // ... dphi_right(...)
+
   const DomainType lower_left_;
   const DomainType upper_right_;
   const DomainType boundary_layer_;
@@ -107,21 +107,21 @@ private:
   public:
     int order(const XT::Common::Parameter& param = {}) const override final
     {
-      auto parsed_param = this->parse_parameter(param);
+      auto parsed_param = parse(param);
       return order_(parsed_param);
     }
 
     RangeReturnType evaluate(const DomainType& point_in_local_coordinates,
                              const Common::Parameter& param = {}) const override final
     {
-      auto parsed_param = this->parse_parameter(param);
+      auto parsed_param = parse(param);
       return evaluate_(point_in_local_coordinates, parsed_param);
     }
 
     DerivativeRangeReturnType jacobian(const DomainType& point_in_local_coordinates,
                                        const Common::Parameter& param = {}) const override final
     {
-      auto parsed_param = this->parse_parameter(param);
+      auto parsed_param = parse(param);
       auto local_jacobian = jacobian_(point_in_local_coordinates, parsed_param);
       const auto J_inv_T = this->element().geometry().jacobianInverseTransposed(point_in_local_coordinates);
       return JacobianHelper<>::jacobian(local_jacobian, J_inv_T);
@@ -134,7 +134,7 @@ private:
       DUNE_THROW(Dune::NotImplemented,
                  "This function should also transform the derivatives (like the jacobian method), go ahead and "
                  "implement if you want to use this method!");
-      auto parsed_param = this->parse_parameter(param);
+      auto parsed_param = parse(param);
       return derivative_(alpha, point_in_local_coordinates, parsed_param);
     }
 
@@ -144,6 +144,12 @@ private:
     }
 
   private:
+    /// the parsed param, or the parsed bound parameter (see bind_parameter) if param is empty
+    Common::Parameter parse(const Common::Parameter& param) const
+    {
+      return this->parse_parameter(param.empty() ? this->bound_parameter() : param);
+    }
+
     template <size_t range_cols = rC, bool anything = true>
     struct JacobianHelper
     {
@@ -14,6 +14,7 @@
 #include <dune/xt/la/container/eye-matrix.hh>
 #include <dune/xt/functions/base/function-as-grid-function.hh>
 #include <dune/xt/functions/base/combined-grid-functions.hh>
+#include <dune/xt/functions/base/scaled-identity.hh>
 #include <dune/xt/functions/constant.hh>
 #include <dune/xt/functions/interfaces/function.hh>
 #include <dune/xt/functions/interfaces/grid-function.hh>
@@ -169,6 +170,9 @@ private:
 /**
  * \brief Wraps a value, a function or a grid function (variant for square matrices).
  *
+ *        Scalar values, functions and grid functions are multiplied by the unit matrix, see
+ *        ScaledIdentityGridFunction.
+ *
  * \sa GridFunction
  */
 template <class E, size_t r, class R>
@@ -178,10 +182,11 @@ class GridFunction<E, r, r, R> : public GridFunctionInterface<E, r, r, R>
   using ThisType = GridFunction<E, r, r, R>;
 
 private:
-  static GridFunctionInterface<E, r, r, R>* unit_matrix()
+  static typename FunctionInterface<BaseType::d, r, r, R>::RangeReturnType scaled_unit_matrix(const R& value)
   {
-    return new FunctionAsGridFunctionWrapper<E, r, r, R>(new ConstantFunction<d, r, r, R>(
-        XT::LA::eye_matrix<typename FunctionInterface<d, r, r, R>::RangeReturnType>(r, r)));
+    auto ret = XT::LA::eye_matrix<typename FunctionInterface<BaseType::d, r, r, R>::RangeReturnType>(r, r);
+    ret *= value;
+    return ret;
   }
 
 public:
@@ -190,8 +195,8 @@ public:
   using typename BaseType::LocalFunctionType;
 
   GridFunction(const R& value)
-    : storage_(new ProductGridFunction<GridFunction<E, 1, 1, R>, GridFunctionInterface<E, r, r, R>>(
-          new GridFunction<E, 1, 1, R>(value), std::move(unit_matrix()), ""))
+    : storage_(
+          new FunctionAsGridFunctionWrapper<E, r, r, R>(new ConstantFunction<d, r, r, R>(scaled_unit_matrix(value))))
   {}
 
   GridFunction(const FieldMatrix<R, r, r>& value) // <- Must not be XT::Common::FIeldMatrix!
@@ -199,15 +204,12 @@ public:
   {}
 
   GridFunction(const FunctionInterface<d, 1, 1, R>& func)
-    : storage_(new ProductGridFunction<FunctionAsGridFunctionWrapper<E, 1, 1, R>, GridFunctionInterface<E, r, r, R>>(
-          new FunctionAsGridFunctionWrapper<E, 1, 1, R>(func), std::move(unit_matrix()), func.name()))
+    : storage_(new ScaledIdentityGridFunction<E, r, R>(new FunctionAsGridFunctionWrapper<E, 1, 1, R>(func)))
   {}
 
   GridFunction(FunctionInterface<d, 1, 1, R>*&& func_ptr)
-    : storage_(new ProductGridFunction<FunctionAsGridFunctionWrapper<E, 1, 1, R>, GridFunctionInterface<E, r, r, R>>(
-          new FunctionAsGridFunctionWrapper<E, 1, 1, R>(std::move(func_ptr)),
-          std::move(unit_matrix()),
-          func_ptr->name()))
+    : storage_(
+          new ScaledIdentityGridFunction<E, r, R>(new FunctionAsGridFunctionWrapper<E, 1, 1, R>(std::move(func_ptr))))
   {}
 
   GridFunction(const FunctionInterface<d, r, r, R>& func)
@@ -219,13 +221,11 @@ public:
   {}
 
   GridFunction(const GridFunctionInterface<E, 1, 1, R>& func)
-    : storage_(new ProductGridFunction<GridFunction<E, 1, 1, R>, GridFunctionInterface<E, r, r, R>>(
-          new GridFunction<E, 1, 1, R>(func), std::move(unit_matrix()), func.name()))
+    : storage_(new ScaledIdentityGridFunction<E, r, R>(func))
   {}
 
   GridFunction(GridFunctionInterface<E, 1, 1, R>*&& func_ptr)
-    : storage_(new ProductGridFunction<GridFunctionInterface<E, 1, 1, R>, GridFunctionInterface<E, r, r, R>>(
-          std::move(func_ptr), std::move(unit_matrix()), func_ptr->name()))
+    : storage_(new ScaledIdentityGridFunction<E, r, R>(std::move(func_ptr)))
   {}
 
   GridFunction(const GridFunctionInterface<E, r, r, R>& func)
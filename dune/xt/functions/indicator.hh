@@ -27,12 +27,12 @@ namespace Functions {
 
 
 template <class E, size_t r, size_t rC = 1, class R = double>
-class IndicatorGridFunction : public GridFunctionInterface<E, r, rC, R>
+class IndicatorGridFunction : public StaticGridFunctionInterface<IndicatorGridFunction<E, r, rC, R>, E, r, rC, R>
 {
-  using BaseType = GridFunctionInterface<E, r, rC, R>;
+  using BaseType = StaticGridFunctionInterface<IndicatorGridFunction<E, r, rC, R>, E, r, rC, R>;
   using ThisType = IndicatorGridFunction<E, r, rC, R>;
 
-  class LocalIndicatorGridFunction : public ElementFunctionInterface<E, r, rC, R>
+  class LocalIndicatorGridFunction final : public ElementFunctionInterface<E, r, rC, R>
   {
     using InterfaceType = ElementFunctionInterface<E, r, rC, R>;
 
@@ -97,6 +97,7 @@ public:
   using typename BaseType::D;
   using typename BaseType::ElementType;
   using typename BaseType::LocalFunctionType;
+  using StaticLocalFunctionType = LocalIndicatorGridFunction;
 
   static const bool available = true;
 
@@ -149,7 +150,7 @@ FunctionType function({{{{0., 1.}, {0., 1.}}, 0.7}, {{{6., 10.}, {8., 10.}}, 0.9
     return name_;
   }
 
-  std::unique_ptr<LocalFunctionType> local_function() const override final
+  std::unique_ptr<StaticLocalFunctionType> static_local_function() const
   {
     return std::make_unique<LocalIndicatorGridFunction>(subdomain_and_value_tuples_);
   }
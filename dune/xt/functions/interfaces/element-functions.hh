@@ -20,6 +20,7 @@
 
 #include <dune/common/fvector.hh>
 
+#include <dune/geometry/quadraturerules.hh>
 #include <dune/geometry/referenceelements.hh>
 
 #include <dune/xt/common/float_cmp.hh>
@@ -64,6 +65,68 @@ namespace internal {
 
 template <class LeftType, class RightType, CombinationType>
 class CombinedElementFunctionHelper;
+
+
+/**
+ * \brief Writes all entries of a (possibly nested) value row-wise to dst and advances dst accordingly.
+ * \{
+ */
+template <class K>
+void write_entries(const K& value, K*& dst)
+{
+  *dst++ = value;
+}
+
+template <class K, class V, int ROWS, int COLS>
+void write_entries(const FieldMatrix<V, ROWS, COLS>& matrix, K*& dst);
+
+template <class K, class V, int SIZE>
+void write_entries(const FieldVector<V, SIZE>& vector, K*& dst)
+{
+  for (int ii = 0; ii < SIZE; ++ii)
+    write_entries(vector[ii], dst);
+}
+
+template <class K, class V, int ROWS, int COLS>
+void write_entries(const FieldMatrix<V, ROWS, COLS>& matrix, K*& dst)
+{
+  for (int ii = 0; ii < ROWS; ++ii)
+    write_entries(matrix[ii], dst);
+}
+/// \}
+
+
+} // namespace internal
+
+
+/**
+ * \brief Memory layout of the values (or jacobians) of a set of element functions at several points, see
+ *        ElementFunctionSetInterface::evaluate_at_points and set_evaluation_index.
+ */
+enum class SetEvaluationLayout
+{
+  point_function_component, ///< all functions at the first point, then all functions at the second point, ...
+  function_point_component  ///< the first function at all points, then the second function at all points, ...
+};
+
+
+/**
+ * \brief Position of the value of the ii-th function at the pp-th point in a result of
+ *        ElementFunctionSetInterface::evaluate_at_points (or jacobians_at_points), in units of values.
+ *
+ *        The first entry of this value is thus given by result[set_evaluation_index(...) * num_components], where
+ *        num_components is r * rC for values and r * rC * d for jacobians.
+ */
+inline size_t set_evaluation_index(const SetEvaluationLayout layout,
+                                   const size_t num_points,
+                                   const size_t set_size,
+                                   const size_t pp,
+                                   const size_t ii)
+{
+  if (layout == SetEvaluationLayout::point_function_component)
+    return pp * set_size + ii;
+  else
+    return ii * num_points + pp;
 }
 
 
@@ -75,6 +138,10 @@ class CombinedElementFunctionHelper;
  *
  *        See in particular RangeTypeSelector and DerivativeRangeTypeSelector for the interpretation of a function and
  *        its derivatives.
+ *
+ * \note  The default implementations of the evaluations do not modify the object (their temporary values are kept in
+ *        thread local buffers, see ScratchSpace), so a bound object may be evaluated concurrently by several threads,
+ *        unless an implementation states otherwise. Binding modifies the object, though.
  **/
 template <class Element, size_t rangeDim = 1, size_t rangeDimCols = 1, class RangeField = double>
 class ElementFunctionSetInterface
@@ -139,6 +206,34 @@ public:
 
   virtual ~ElementFunctionSetInterface() = default;
 
+  /**
+   * \brief Binds a parameter, to be used by all subsequent evaluations which are called with an empty parameter.
+   *
+   *        This allows parametric local functions to prepare everything depending on the parameter once (see
+   *        post_bind_parameter), instead of on each evaluation, as in:
+\code
+local_function.bind_parameter(param);
+for (auto&& element : elements(grid_view)) {
+  local_function.bind(element);
+  ... local_function.evaluate(x) ...
+}
+\endcode
+   *
+   * \note Only parametric local functions (and those composed of other local functions) implement
+   *       post_bind_parameter, all others do not depend on the parameter.
+   */
+  ThisType& bind_parameter(const Common::Parameter& param)
+  {
+    bound_parameter_ = param;
+    this->post_bind_parameter(bound_parameter_);
+    return *this;
+  }
+
+  const Common::Parameter& bound_parameter() const
+  {
+    return bound_parameter_;
+  }
+
   /**
    * \name ´´These methods have to be implemented.''
    * \{
@@ -212,6 +307,88 @@ assert(max_set_size <= local_function_set.max_size());
           "This set of element functions does not provide arbitrary derivatives, override the 'derivatives' method!");
   }
 
+  /**
+   * Evaluates all functions of the set and their jacobians at once. Sets of functions whose values and jacobians share
+   * intermediate results should override this method, the default implementation simply calls evaluate and jacobians.
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void evaluate_with_jacobians(const DomainType& point_in_reference_element,
+                                       std::vector<RangeType>& values,
+                                       std::vector<DerivativeRangeType>& jacobians,
+                                       const Common::Parameter& param = {}) const
+  {
+    this->evaluate(point_in_reference_element, values, param);
+    this->jacobians(point_in_reference_element, jacobians, param);
+  }
+
+  /**
+   * \}
+   * \name ´´These methods evaluate the set at all points of a quadrature at once and should be overridden to improve
+   *         their performance.''
+   * \{
+   **/
+
+  /**
+   * Evaluates all functions of the set at all points of quadrature (in reference element coordinates) and writes the
+   * entries of each value row-wise to result, where layout determines the order of the values, see
+   * set_evaluation_index. result has to hold quadrature.size() * size(param) * r * rC entries.
+   *
+   * Contrary to evaluate_set, no memory is allocated (once the internal buffer of the default implementation, which
+   * calls evaluate for each point, holds size(param) values).
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void evaluate_at_points(const QuadratureRule<D, d>& quadrature,
+                                  R* result,
+                                  const SetEvaluationLayout layout = SetEvaluationLayout::point_function_component,
+                                  const Common::Parameter& param = {}) const
+  {
+    const size_t num_points = quadrature.size();
+    const size_t sz = this->size(param);
+    ScratchSpace<RangeType> tmp_values(sz);
+    for (size_t pp = 0; pp < num_points; ++pp) {
+      this->evaluate(quadrature[pp].position(), tmp_values.get(), param);
+      for (size_t ii = 0; ii < sz; ++ii) {
+        R* dst = result + set_evaluation_index(layout, num_points, sz, pp, ii) * r * rC;
+        internal::write_entries(tmp_values.get()[ii], dst);
+      }
+    }
+  } // ... evaluate_at_points(...)
+
+  /**
+   * Same as evaluate_at_points for the jacobians, the entries of each jacobian are written in the order [row][col][dd].
+   * result has to hold quadrature.size() * size(param) * r * rC * d entries.
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void jacobians_at_points(const QuadratureRule<D, d>& quadrature,
+                                   R* result,
+                                   const SetEvaluationLayout layout = SetEvaluationLayout::point_function_component,
+                                   const Common::Parameter& param = {}) const
+  {
+    const size_t num_points = quadrature.size();
+    const size_t sz = this->size(param);
+    ScratchSpace<DerivativeRangeType> tmp_derivatives(sz);
+    for (size_t pp = 0; pp < num_points; ++pp) {
+      this->jacobians(quadrature[pp].position(), tmp_derivatives.get(), param);
+      for (size_t ii = 0; ii < sz; ++ii) {
+        R* dst = result + set_evaluation_index(layout, num_points, sz, pp, ii) * r * rC * d;
+        internal::write_entries(tmp_derivatives.get()[ii], dst);
+      }
+    }
+  } // ... jacobians_at_points(...)
+
+  /**
+   * Returns true if the values of this set at a point in reference element coordinates are the same on all elements
+   * (as for shape functions), and its jacobians only differ by the transformation with the jacobian of the geometry of
+   * the element. Such sets are only evaluated once on affine elements by ElementFunctionSetTabulation.
+   **/
+  virtual bool is_element_invariant(const Common::Parameter& /*param*/ = {}) const
+  {
+    return false;
+  }
+
   /**
    * \{
    * \name ´´These methods are provided for convenience and should not be used within library code.''
@@ -269,10 +446,12 @@ assert(max_set_size <= local_function_set.max_size());
                         const Common::Parameter& param = {}) const
   {
     assert_correct_dims(row, col, "evaluate");
-    const auto tmp_values = this->evaluate_set(point_in_reference_element, param);
-    if (result.size() < tmp_values.size())
-      result.resize(tmp_values.size());
-    single_evaluate_helper<>::call(tmp_values, row, col, result);
+    const auto sz = this->size(param);
+    ScratchSpace<RangeType> tmp_values(sz);
+    this->evaluate(point_in_reference_element, tmp_values.get(), param);
+    if (result.size() < sz)
+      result.resize(sz);
+    single_evaluate_helper<>::call(tmp_values.get(), sz, row, col, result);
   }
 
   /**
@@ -285,10 +464,12 @@ assert(max_set_size <= local_function_set.max_size());
                          const Common::Parameter& param = {}) const
   {
     assert_correct_dims(row, col, "jacobians");
-    const auto tmp_values = this->jacobians_of_set(point_in_reference_element, param);
-    if (result.size() < tmp_values.size())
-      result.resize(tmp_values.size());
-    single_derivative_helper<>::call(tmp_values, row, col, result);
+    const auto sz = this->size(param);
+    ScratchSpace<DerivativeRangeType> tmp_derivatives(sz);
+    this->jacobians(point_in_reference_element, tmp_derivatives.get(), param);
+    if (result.size() < sz)
+      result.resize(sz);
+    single_derivative_helper<>::call(tmp_derivatives.get(), sz, row, col, result);
   }
 
   /**
@@ -302,10 +483,12 @@ assert(max_set_size <= local_function_set.max_size());
                            const Common::Parameter& param = {}) const
   {
     assert_correct_dims(row, col, "derivatives");
-    const auto tmp_values = this->derivatives_of_set(alpha, point_in_reference_element, param);
-    if (result.size() < tmp_values.size())
-      result.resize(tmp_values.size());
-    single_derivative_helper<>::call(tmp_values, row, col, result);
+    const auto sz = this->size(param);
+    ScratchSpace<DerivativeRangeType> tmp_derivatives(sz);
+    this->derivatives(alpha, point_in_reference_element, tmp_derivatives.get(), param);
+    if (result.size() < sz)
+      result.resize(sz);
+    single_derivative_helper<>::call(tmp_derivatives.get(), sz, row, col, result);
   }
 
   /**
@@ -329,11 +512,11 @@ assert(max_set_size <= local_function_set.max_size());
     for (size_t ii = 0; ii < sz; ++ii)
       RangeSelector::ensure_size(result[ii]);
     // call actual evaluate
-    auto tmp_result = std::make_unique<std::vector<RangeType>>(sz);
-    this->evaluate(point_in_reference_element, *tmp_result, param);
+    ScratchSpace<RangeType> tmp_values(sz);
+    this->evaluate(point_in_reference_element, tmp_values.get(), param);
     // convert
     for (size_t ii = 0; ii < sz; ++ii)
-      RangeSelector::convert((*tmp_result)[ii], result[ii]);
+      RangeSelector::convert(tmp_values.get()[ii], result[ii]);
   } // ... evaluate(...)
 
   /**
@@ -350,11 +533,11 @@ assert(max_set_size <= local_function_set.max_size());
     for (size_t ii = 0; ii < sz; ++ii)
       DerivativeRangeSelector::ensure_size(result[ii]);
     // call actual jacobians
-    auto tmp_result = std::make_unique<std::vector<DerivativeRangeType>>(sz);
-    this->jacobians(point_in_reference_element, *tmp_result, param);
+    ScratchSpace<DerivativeRangeType> tmp_derivatives(sz);
+    this->jacobians(point_in_reference_element, tmp_derivatives.get(), param);
     // convert
     for (size_t ii = 0; ii < sz; ++ii)
-      DerivativeRangeSelector::convert((*tmp_result)[ii], result[ii]);
+      DerivativeRangeSelector::convert(tmp_derivatives.get()[ii], result[ii]);
   } // ... jacobians(...)
 
   /**
@@ -372,17 +555,23 @@ assert(max_set_size <= local_function_set.max_size());
     for (size_t ii = 0; ii < sz; ++ii)
       DerivativeRangeSelector::ensure_size(result[ii]);
     // call actual derivatives
-    auto tmp_result = std::make_unique<std::vector<DerivativeRangeType>>(sz);
-    this->derivatives(alpha, point_in_reference_element, *tmp_result, param);
+    ScratchSpace<DerivativeRangeType> tmp_derivatives(sz);
+    this->derivatives(alpha, point_in_reference_element, tmp_derivatives.get(), param);
     // convert
     for (size_t ii = 0; ii < sz; ++ii)
-      DerivativeRangeSelector::convert((*tmp_result)[ii], result[ii]);
+      DerivativeRangeSelector::convert(tmp_derivatives.get()[ii], result[ii]);
   } // ... derivatives(...)
 
   /**
    * \}
    **/
 protected:
+  /**
+   * \brief Called by bind_parameter, parametric local functions should prepare their evaluations with an empty
+   *        parameter for param here.
+   */
+  virtual void post_bind_parameter(const Common::Parameter& /*param*/) {}
+
 #ifndef DUNE_XT_FUNCTIONS_DISABLE_CHECKS
   void assert_inside_reference_element(const DomainType& point_in_reference_element) const
   {
@@ -416,9 +605,10 @@ private:
   struct single_evaluate_helper
   {
     template <class FullType>
-    static void call(const std::vector<FullType>& val, const size_t row, const size_t col, std::vector<R>& ret)
+    static void
+    call(const std::vector<FullType>& val, const size_t sz, const size_t row, const size_t col, std::vector<R>& ret)
     {
-      for (size_t ii = 0; ii < val.size(); ++ii)
+      for (size_t ii = 0; ii < sz; ++ii)
         ret[ii] = val[ii][row][col];
     }
   }; // struct single_evaluate_helper<...>
@@ -427,9 +617,10 @@ private:
   struct single_evaluate_helper<_r, 1, anything>
   {
     template <class FullType>
-    static void call(const std::vector<FullType>& val, const size_t row, const size_t /*col*/, std::vector<R>& ret)
+    static void
+    call(const std::vector<FullType>& val, const size_t sz, const size_t row, const size_t /*col*/, std::vector<R>& ret)
     {
-      for (size_t ii = 0; ii < val.size(); ++ii)
+      for (size_t ii = 0; ii < sz; ++ii)
         ret[ii] = val[ii][row];
     }
   }; // struct single_evaluate_helper<..., 1, ...>
@@ -438,9 +629,13 @@ private:
   struct single_derivative_helper
   {
     template <class FullType, class SingleType>
-    static void call(const std::vector<FullType>& val, const size_t row, const size_t col, std::vector<SingleType>& ret)
+    static void call(const std::vector<FullType>& val,
+                     const size_t sz,
+                     const size_t row,
+                     const size_t col,
+                     std::vector<SingleType>& ret)
     {
-      for (size_t ii = 0; ii < val.size(); ++ii)
+      for (size_t ii = 0; ii < sz; ++ii)
         for (size_t dd = 0; dd < d; ++dd)
           ret[ii][dd] = val[ii][row][col][dd];
     }
@@ -450,13 +645,73 @@ private:
   struct single_derivative_helper<_r, 1, anything>
   {
     template <class FullType, class SingleType>
-    static void
-    call(const std::vector<FullType>& val, const size_t row, const size_t /*col*/, std::vector<SingleType>& ret)
+    static void call(const std::vector<FullType>& val,
+                     const size_t sz,
+                     const size_t row,
+                     const size_t /*col*/,
+                     std::vector<SingleType>& ret)
     {
-      for (size_t ii = 0; ii < val.size(); ++ii)
+      for (size_t ii = 0; ii < sz; ++ii)
         ret[ii] = val[ii][row];
     }
   }; // struct single_derivative_helper<..., 1, ...>
+
+  /**
+   * \brief Provides a buffer (resized to hold at least sz entries) as scratch space for the lifetime of this object, or
+   *        a temporary vector if the buffer is already in use further up the call stack.
+   *
+   *        The buffer is thread local (and shared by all objects of this type within one thread), so concurrent
+   *        evaluations do not interfere. The temporary is required if an implementation of, e.g., evaluate calls
+   *        another method which requires the same buffer, which would otherwise overwrite the values of the caller.
+   */
+  template <class T>
+  class ScratchSpace
+  {
+  public:
+    explicit ScratchSpace(const size_t sz)
+      : borrows_buffer_(!buffer_in_use())
+      , temporary_()
+      , vector_(borrows_buffer_ ? buffer() : temporary_)
+    {
+      buffer_in_use() = true;
+      if (vector_.size() < sz)
+        vector_.resize(sz);
+    }
+
+    ScratchSpace(const ScratchSpace& /*other*/) = delete;
+
+    ScratchSpace& operator=(const ScratchSpace& /*other*/) = delete;
+
+    ~ScratchSpace()
+    {
+      if (borrows_buffer_)
+        buffer_in_use() = false;
+    }
+
+    std::vector<T>& get()
+    {
+      return vector_;
+    }
+
+  private:
+    static std::vector<T>& buffer()
+    {
+      static thread_local std::vector<T> buffer_;
+      return buffer_;
+    }
+
+    static bool& buffer_in_use()
+    {
+      static thread_local bool buffer_in_use_ = false;
+      return buffer_in_use_;
+    }
+
+    const bool borrows_buffer_;
+    std::vector<T> temporary_;
+    std::vector<T>& vector_;
+  }; // class ScratchSpace
+
+  Common::Parameter bound_parameter_;
 }; // class ElementFunctionSetInterface
 
 
@@ -549,6 +804,21 @@ public:
                "This local function does not provide arbitrary derivatives, override the 'derivative' method!");
   }
 
+  /**
+   * \brief Evaluates the function and its jacobian at once.
+   *
+   *        Local functions whose value and jacobian share intermediate results should override this method, the
+   *        default implementation simply calls evaluate and jacobian.
+   */
+  virtual void evaluate_with_jacobian(const DomainType& point_in_reference_element,
+                                      RangeReturnType& value,
+                                      DerivativeRangeReturnType& jacobian,
+                                      const Common::Parameter& param = {}) const
+  {
+    value = this->evaluate(point_in_reference_element, param);
+    jacobian = this->jacobian(point_in_reference_element, param);
+  }
+
   /**
    * \}
    * \name ´´These methods are used to access individual range dimensions and should be overridden to improve their
@@ -677,6 +947,22 @@ public:
     result[0] = this->derivative(alpha, point_in_reference_element, param);
   }
 
+  void evaluate_with_jacobians(const DomainType& point_in_reference_element,
+                               std::vector<RangeType>& values,
+                               std::vector<DerivativeRangeType>& jacobians,
+                               const Common::Parameter& param = {}) const override
+  {
+    if (values.size() < 1)
+      values.resize(1);
+    if (jacobians.size() < 1)
+      jacobians.resize(1);
+    RangeReturnType value;
+    DerivativeRangeReturnType jacobian;
+    this->evaluate_with_jacobian(point_in_reference_element, value, jacobian, param);
+    values[0] = value;
+    jacobians[0] = jacobian;
+  }
+
   /**
    * \}
    * \name ´´These operators are provided for convenience.''
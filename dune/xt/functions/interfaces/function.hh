@@ -12,8 +12,10 @@
 #ifndef DUNE_XT_FUNCTIONS_INTERFACES_FUNCTION_HH
 #define DUNE_XT_FUNCTIONS_INTERFACES_FUNCTION_HH
 
+#include <atomic>
 #include <memory>
-#include <map>
+#include <typeindex>
+#include <typeinfo>
 
 #include <dune/common/fvector.hh>
 
@@ -44,6 +46,102 @@ class ProductFunction;
 template <class E, size_t r, size_t rC, class R>
 class FunctionAsGridFunctionWrapper;
 
+template <class FunctionType>
+class ParameterBoundFunction;
+
+namespace internal {
+
+
+/**
+ * \brief Holds at most one object of each type, which is created on first access, used in
+ *        FunctionInterface::as_grid_function.
+ *
+ *        Access is thread safe and lock-free: the objects are kept in a singly linked list, to which new objects are
+ *        prepended by compare-and-swap. If two threads create an object of the same type concurrently, the one losing
+ *        the race discards its object. Objects are never removed before the cache is destroyed, so references to them
+ *        remain valid as long as the cache. Copies of a cache start empty.
+ */
+class TypeIndexedCache
+{
+  struct Node
+  {
+    Node(const std::type_info& tp, std::shared_ptr<void>&& obj)
+      : type(tp)
+      , object(std::move(obj))
+      , next(nullptr)
+    {}
+
+    const std::type_index type;
+    const std::shared_ptr<void> object;
+    Node* next;
+  }; // struct Node
+
+public:
+  TypeIndexedCache()
+    : head_(nullptr)
+  {}
+
+  TypeIndexedCache(const TypeIndexedCache& /*other*/)
+    : head_(nullptr)
+  {}
+
+  TypeIndexedCache& operator=(const TypeIndexedCache& /*other*/)
+  {
+    return *this;
+  }
+
+  ~TypeIndexedCache()
+  {
+    Node* node = head_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  /**
+   * \brief Returns the object of type T, which is obtained from create() (returning a std::unique_ptr<T>) if not
+   *        present yet.
+   */
+  template <class T, class CreatorType>
+  T& get(const CreatorType& create) const
+  {
+    Node* head = head_.load(std::memory_order_acquire);
+    T* existing = find<T>(head, nullptr);
+    if (existing != nullptr)
+      return *existing;
+    std::unique_ptr<T> object = create();
+    T* const object_ptr = object.get();
+    std::unique_ptr<Node> node = std::make_unique<Node>(typeid(T), std::shared_ptr<void>(std::move(object)));
+    node->next = head;
+    while (!head_.compare_exchange_weak(node->next, node.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+      // node->next now is the current head, check the nodes prepended in the meantime
+      existing = find<T>(node->next, head);
+      if (existing != nullptr)
+        return *existing;
+      head = node->next;
+    }
+    node.release();
+    return *object_ptr;
+  } // ... get(...)
+
+private:
+  template <class T>
+  static T* find(const Node* first, const Node* last)
+  {
+    for (const Node* node = first; node != last; node = node->next)
+      if (node->type == std::type_index(typeid(T)))
+        return static_cast<T*>(node->object.get());
+    return nullptr;
+  }
+
+  mutable std::atomic<Node*> head_;
+}; // class TypeIndexedCache
+
+
+} // namespace internal
+
 
 /**
  * \brief Interface for functions (in the C^\infty sense) which can thus be evaluated in global coordinates.
@@ -187,6 +285,35 @@ public:
     return Functions::ProductFunction<ThisType, OtherType>(*this, other);
   }
 
+  /**
+   * \brief Evaluates the function and its jacobian at once.
+   *
+   *        Functions whose value and jacobian share intermediate results should override this method, the default
+   *        implementation simply calls evaluate and jacobian.
+   */
+  virtual void evaluate_with_jacobian(const DomainType& point_in_global_coordinates,
+                                      RangeReturnType& value,
+                                      DerivativeRangeReturnType& jacobian,
+                                      const Common::Parameter& param = {}) const
+  {
+    value = this->evaluate(point_in_global_coordinates, param);
+    jacobian = this->jacobian(point_in_global_coordinates, param);
+  }
+
+  /**
+   * \brief Returns this function with its parameter fixed to param, as a non-parametric function to be evaluated
+   *        repeatedly (without passing a parameter).
+   *
+   *        The default implementation parses param once and passes it on to each evaluation, parametric functions
+   *        should override this to avoid any remaining work per evaluation, see e.g. ParametricExpressionFunction.
+   *
+   * \note  The returned function may refer to this function, which thus has to outlive it.
+   */
+  virtual std::unique_ptr<ThisType> with_parameter(const Common::Parameter& param) const
+  {
+    return std::make_unique<ParameterBoundFunction<ThisType>>(*this, param);
+  }
+
   virtual R evaluate(const DomainType& point_in_global_coordinates,
                      const size_t row,
                      const size_t col = 0,
@@ -256,18 +383,17 @@ public:
    **/
 
   /**
-   * \note This function keeps a map of all wrappers in a local static map, to avoid temporaries.
-   * \todo Check if this implementation is thread safe!
+   * \note The wrapper is created on the first call for each E and kept within this function (so the returned reference
+   *       is valid as long as this function), calling this method concurrently is thread safe.
    */
   template <class E>
   const typename std::enable_if<XT::Grid::is_entity<E>::value && E::dimension == d,
                                 FunctionAsGridFunctionWrapper<E, r, rC, R>>::type&
   as_grid_function() const
   {
-    static std::map<const ThisType*, std::unique_ptr<FunctionAsGridFunctionWrapper<E, r, rC, R>>> wrappers;
-    if (wrappers.find(this) == wrappers.end())
-      wrappers[this] = std::make_unique<FunctionAsGridFunctionWrapper<E, r, rC, R>>(*this);
-    return *(wrappers[this]);
+    using WrapperType = FunctionAsGridFunctionWrapper<E, r, rC, R>;
+    return as_grid_function_wrappers_.template get<WrapperType>(
+        [&]() { return std::make_unique<WrapperType>(*this); });
   }
 
   template <class ViewTraits>
@@ -367,6 +493,8 @@ private:
       return val[row];
     }
   }; // struct single_derivative_helper<r, 1, ...>
+
+  internal::TypeIndexedCache as_grid_function_wrappers_;
 }; // class FunctionInterface
 
 
@@ -378,6 +506,7 @@ private:
 #include <dune/xt/functions/base/combined-functions.hh>
 #include <dune/xt/functions/base/function-as-grid-function.hh>
 #include <dune/xt/functions/base/function-as-flux-function.hh>
+#include <dune/xt/functions/base/parameter-bound-function.hh>
 
 
 #endif // DUNE_XT_FUNCTIONS_INTERFACES_SMOOTH_FUNCTION_HH
@@ -13,9 +13,11 @@
 #ifndef DUNE_XT_FUNCTIONS_INTERFACES_GRID_FUNCTION_HH
 #define DUNE_XT_FUNCTIONS_INTERFACES_GRID_FUNCTION_HH
 
+#include <atomic>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -56,6 +58,77 @@ class ProductGridFunction;
 // template <class Function>
 // class DivergenceFunction;
 
+namespace internal {
+
+
+/**
+ * \brief Holds an object of type T for each thread which called get(), used in
+ *        GridFunctionInterface::thread_local_function.
+ *
+ *        Threads only ever add their own object, so a lock-free linked list suffices. A copy starts empty.
+ */
+template <class T>
+class PerThreadCache
+{
+  struct Node
+  {
+    Node(std::unique_ptr<T>&& obj)
+      : thread(std::this_thread::get_id())
+      , object(std::move(obj))
+      , next(nullptr)
+    {}
+
+    const std::thread::id thread;
+    const std::unique_ptr<T> object;
+    Node* next;
+  }; // struct Node
+
+public:
+  PerThreadCache()
+    : head_(nullptr)
+  {}
+
+  PerThreadCache(const PerThreadCache& /*other*/)
+    : head_(nullptr)
+  {}
+
+  PerThreadCache& operator=(const PerThreadCache& /*other*/)
+  {
+    return *this;
+  }
+
+  ~PerThreadCache()
+  {
+    Node* node = head_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  /// \brief Returns the object of the calling thread, which is obtained from create() if not present yet.
+  template <class CreatorType>
+  T& get(const CreatorType& create) const
+  {
+    const auto this_thread = std::this_thread::get_id();
+    for (const Node* node = head_.load(std::memory_order_acquire); node != nullptr; node = node->next)
+      if (node->thread == this_thread)
+        return *node->object;
+    auto node = std::make_unique<Node>(create());
+    node->next = head_.load(std::memory_order_acquire);
+    while (!head_.compare_exchange_weak(node->next, node.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+      ;
+    return *node.release()->object;
+  } // ... get(...)
+
+private:
+  mutable std::atomic<Node*> head_;
+}; // class PerThreadCache
+
+
+} // namespace internal
+
 
 /**
  * \brief Interface for functions which can be localized to an element.
@@ -113,6 +186,35 @@ public:
 
   virtual std::unique_ptr<LocalFunctionType> local_function() const = 0;
 
+  /**
+   * \}
+   * \name ´´These methods are provided by the interface.''
+   * \{
+   **/
+
+  /**
+   * \brief Returns a local function which is owned by this function and reserved for the calling thread.
+   *
+   *        It is obtained from local_function() on the first call of each thread and reused afterwards, so that the
+   *        complete tree of local functions of combined functions (see, e.g., SumGridFunction) is only allocated once
+   *        per thread, instead of on each call to local_function():
+\code
+// within each thread
+auto& local_f = f.thread_local_function();
+for (auto&& element : elements(grid_view)) {
+  local_f.bind(element);
+  ...
+}
+\endcode
+   *
+   * \note All callers within one thread share this local function: do not use it where another (nested) user might
+   *       bind it to a different element in between, use local_function() instead.
+   */
+  LocalFunctionType& thread_local_function() const
+  {
+    return thread_local_functions_.get([&]() { return this->local_function(); });
+  }
+
   /**
    * \}
    * \name ´´These methods should be implemented in order to identify the function.''
@@ -146,6 +248,8 @@ public:
   /**
    * \note  We use the SubsamplingVTKWriter (which is better for higher orders) by default: the grid you see in the
    *        visualization may thus be a refinement of the actual grid!
+   * \note  To visualize several functions (and gradients) at once, use visualize(grid_view, path, functions...), which
+   *        traverses the grid only once.
    */
   template <class GridViewType>
   typename std::enable_if<Grid::is_view<GridViewType>::value, void>::type
@@ -227,9 +331,82 @@ public:
     else
       vtk_writer.pwrite(Common::filename_only(path), directory, "", vtk_output_type);
   }
+
+private:
+  internal::PerThreadCache<LocalFunctionType> thread_local_functions_;
 }; // class GridFunctionInterface
 
 
+/**
+ * \brief Static (CRTP) interface for grid functions whose local functions are of a type known at compile time.
+ *
+ *        Derived classes have to provide
+\code
+using StaticLocalFunctionType = ...; // derived from ElementFunctionInterface<E, r, rC, R>
+std::unique_ptr<StaticLocalFunctionType> static_local_function() const;
+\endcode
+ *        and obtain local_function() from it. If the methods of StaticLocalFunctionType are final (which is the case
+ *        for all grid functions in dune-xt-functions), templated code may thus evaluate local functions without
+ *        virtual calls, and small evaluations (as those of a constant or a checkerboard function) may be inlined, see
+ *        is_static_grid_function and static_local_function(grid_function).
+ */
+template <class GridFunctionImp,
+          class Element,
+          size_t rangeDim = 1,
+          size_t rangeDimCols = 1,
+          class RangeField = double>
+class StaticGridFunctionInterface : public GridFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>
+{
+  using BaseType = GridFunctionInterface<Element, rangeDim, rangeDimCols, RangeField>;
+
+public:
+  using typename BaseType::LocalFunctionType;
+  using GridFunctionType = GridFunctionImp;
+
+  StaticGridFunctionInterface(const Common::ParameterType& param_type = {})
+    : BaseType(param_type)
+  {}
+
+  std::unique_ptr<LocalFunctionType> local_function() const override final
+  {
+    return as_imp().static_local_function();
+  }
+
+  const GridFunctionType& as_imp() const
+  {
+    return static_cast<const GridFunctionType&>(*this);
+  }
+}; // class StaticGridFunctionInterface
+
+
+/**
+ * \brief Returns a local function of grid_function, with its static type if available (see
+ *        StaticGridFunctionInterface), to be used in templated code as in
+\code
+template <class GF>
+void apply(const GF& grid_function)
+{
+  auto local_function = static_local_function(grid_function);
+  ...
+}
+\endcode
+ */
+template <class GF>
+std::enable_if_t<is_static_grid_function<GF>::value, std::unique_ptr<typename GF::StaticLocalFunctionType>>
+static_local_function(const GF& grid_function)
+{
+  return grid_function.static_local_function();
+}
+
+template <class GF>
+std::enable_if_t<is_grid_function<GF>::value && !is_static_grid_function<GF>::value,
+                 std::unique_ptr<typename GF::LocalFunctionType>>
+static_local_function(const GF& grid_function)
+{
+  return grid_function.local_function();
+}
+
+
 } // namespace Functions
 } // namespace XT
 } // namespace Dune
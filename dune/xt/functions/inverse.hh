@@ -37,6 +37,7 @@ public:
   using R = typename FunctionType::R;
   using DomainType = Dune::FieldVector<double, d>;
   using RangeReturnType = typename RangeTypeSelector<R, r, rC>::return_type;
+  using DerivativeRangeReturnType = typename DerivativeRangeTypeSelector<d, R, r, rC>::return_type;
 
   template <size_t r_ = r, size_t rC_ = rC, bool anything = true>
   struct dim_switch
@@ -57,6 +58,24 @@ public:
                     "Scalar function value was not invertible!\n\nvalue_to_invert = " << value_to_invert);
       return 1. / value_to_invert;
     }
+
+    /// (1/f)' = -f'/f^2
+    static void compute_with_jacobian(const FunctionType& func,
+                                      const DomainType& xx,
+                                      RangeReturnType& value,
+                                      DerivativeRangeReturnType& jacobian,
+                                      const XT::Common::Parameter& param)
+    {
+      RangeReturnType value_to_invert;
+      DerivativeRangeReturnType jacobian_to_invert;
+      func.evaluate_with_jacobian(xx, value_to_invert, jacobian_to_invert, param);
+      DUNE_THROW_IF(XT::Common::FloatCmp::eq(value_to_invert, 0.),
+                    Exceptions::wrong_input_given,
+                    "Scalar function value was not invertible!\n\nvalue_to_invert = " << value_to_invert);
+      value = 1. / value_to_invert;
+      for (size_t dd = 0; dd < d; ++dd)
+        jacobian[0][dd] = -jacobian_to_invert[0][dd] * value[0] * value[0];
+    }
   };
 
   template <size_t r_, bool anything>
@@ -77,6 +96,39 @@ public:
       }
       return inverse_matrix;
     }
+
+    /// (A^{-1})' = -A^{-1} A' A^{-1}
+    static void compute_with_jacobian(const FunctionType& func,
+                                      const DomainType& xx,
+                                      RangeReturnType& value,
+                                      DerivativeRangeReturnType& jacobian,
+                                      const XT::Common::Parameter& param)
+    {
+      RangeReturnType matrix_to_invert;
+      DerivativeRangeReturnType jacobian_to_invert;
+      func.evaluate_with_jacobian(xx, matrix_to_invert, jacobian_to_invert, param);
+      try {
+        value = XT::LA::invert_matrix(matrix_to_invert);
+      } catch (const XT::LA::Exceptions::matrix_invert_failed& ee) {
+        DUNE_THROW(Exceptions::wrong_input_given,
+                   "Matrix-valued function value was not invertible!\n\nmatrix_to_invert = "
+                       << matrix_to_invert << "\n\nThis was the original error: " << ee.what());
+      }
+      for (size_t dd = 0; dd < d; ++dd) {
+        // tmp = A' A^{-1}
+        RangeReturnType tmp(0.);
+        for (size_t ii = 0; ii < r; ++ii)
+          for (size_t jj = 0; jj < r; ++jj)
+            for (size_t kk = 0; kk < r; ++kk)
+              tmp[ii][jj] += jacobian_to_invert[ii][kk][dd] * value[kk][jj];
+        for (size_t ii = 0; ii < r; ++ii)
+          for (size_t jj = 0; jj < r; ++jj) {
+            jacobian[ii][jj][dd] = 0.;
+            for (size_t kk = 0; kk < r; ++kk)
+              jacobian[ii][jj][dd] -= value[ii][kk] * tmp[kk][jj];
+          }
+      }
+    }
   };
 
 public:
@@ -86,6 +138,15 @@ public:
   {
     return dim_switch<>::compute(func, xx, param);
   }
+
+  static void compute_with_jacobian(const FunctionType& func,
+                                    const DomainType& xx,
+                                    RangeReturnType& value,
+                                    DerivativeRangeReturnType& jacobian,
+                                    const XT::Common::Parameter& param)
+  {
+    dim_switch<>::compute_with_jacobian(func, xx, value, jacobian, param);
+  }
 }; // class InverseFunctionHelper
 
 
@@ -107,6 +168,7 @@ class InverseElementFunction
   using Helper = internal::InverseFunctionHelper<ElementFunctionType>;
 
 public:
+  using typename BaseType::DerivativeRangeReturnType;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::RangeReturnType;
@@ -143,6 +205,22 @@ public:
     return Helper::compute(func_.access(), xx, param);
   }
 
+  DerivativeRangeReturnType jacobian(const DomainType& xx, const Common::Parameter& param = {}) const override final
+  {
+    RangeReturnType value;
+    DerivativeRangeReturnType ret;
+    Helper::compute_with_jacobian(func_.access(), xx, value, ret, param);
+    return ret;
+  }
+
+  void evaluate_with_jacobian(const DomainType& xx,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& param = {}) const override final
+  {
+    Helper::compute_with_jacobian(func_.access(), xx, value, jacobian, param);
+  }
+
 private:
   XT::Common::StorageProvider<ElementFunctionType> func_;
   const int order_;
@@ -164,6 +242,7 @@ class InverseFunction
   using Helper = internal::InverseFunctionHelper<FunctionType>;
 
 public:
+  using typename BaseType::DerivativeRangeReturnType;
   using typename BaseType::DomainType;
   using typename BaseType::RangeReturnType;
 
@@ -192,6 +271,22 @@ public:
     return Helper::compute(func_.access(), xx, param);
   }
 
+  DerivativeRangeReturnType jacobian(const DomainType& xx, const Common::Parameter& param = {}) const override final
+  {
+    RangeReturnType value;
+    DerivativeRangeReturnType ret;
+    Helper::compute_with_jacobian(func_.access(), xx, value, ret, param);
+    return ret;
+  }
+
+  void evaluate_with_jacobian(const DomainType& xx,
+                              RangeReturnType& value,
+                              DerivativeRangeReturnType& jacobian,
+                              const Common::Parameter& param = {}) const override final
+  {
+    Helper::compute_with_jacobian(func_.access(), xx, value, jacobian, param);
+  }
+
 private:
   XT::Common::StorageProvider<FunctionType> func_;
   const int order_;
@@ -0,0 +1,218 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <locale.h>
+#ifdef __APPLE__
+#  include <xlocale.h>
+#endif
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/xt/functions/exceptions.hh>
+
+#include "data.hh"
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace Spe10 {
+namespace {
+
+
+static const char binary_magic[8] = {'D', 'X', 'T', 'S', 'P', 'E', '1', '0'};
+static const std::uint32_t binary_byte_order_mark = 0x01020304;
+static const std::uint32_t binary_version = 1;
+
+
+struct BinaryHeader
+{
+  char magic[8];
+  std::uint32_t byte_order_mark;
+  std::uint32_t version;
+  std::uint32_t value_size;
+  std::uint32_t unused;
+  std::uint64_t num_values;
+};
+
+static_assert(sizeof(BinaryHeader) == 32, "The values following the header would not be aligned!");
+
+
+bool is_binary_header(const char* data, const size_t size)
+{
+  return size >= sizeof(BinaryHeader) && std::memcmp(data, binary_magic, sizeof(binary_magic)) == 0;
+}
+
+
+// Switches the calling thread to the "C" locale while it exists, so that std::strtod does not depend on the global
+// locale (which may, e.g., use a decimal comma).
+class ScopedClassicLocale
+{
+public:
+  ScopedClassicLocale()
+    : locale_(::newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0)))
+    , previous_locale_(static_cast<locale_t>(0))
+  {
+    if (locale_ == static_cast<locale_t>(0))
+      DUNE_THROW(Dune::IOError, "could not create the C locale!");
+    previous_locale_ = ::uselocale(locale_);
+  }
+
+  ScopedClassicLocale(const ScopedClassicLocale&) = delete;
+  ScopedClassicLocale& operator=(const ScopedClassicLocale&) = delete;
+
+  ~ScopedClassicLocale()
+  {
+    ::uselocale(previous_locale_);
+    ::freelocale(locale_);
+  }
+
+private:
+  locale_t locale_;
+  locale_t previous_locale_;
+}; // class ScopedClassicLocale
+
+
+// faster than std::ifstream >> double, which matters for the 3.3M values of model 2
+std::vector<double> parse_ascii_values(const std::string& text, const std::string& filename)
+{
+  const ScopedClassicLocale classic_locale;
+  std::vector<double> values;
+  values.reserve(text.size() / 8);
+  const char* pos = text.c_str();
+  while (true) {
+    while (std::isspace(static_cast<unsigned char>(*pos)))
+      ++pos;
+    if (*pos == '\0')
+      break;
+    char* end = nullptr;
+    const double value = std::strtod(pos, &end);
+    if (end == pos)
+      DUNE_THROW(Dune::IOError,
+                 "could not parse value " << values.size() << " of '" << filename << "' (at '"
+                                          << std::string(pos, std::min(std::strlen(pos), size_t(16))) << "')!");
+    values.push_back(value);
+    pos = end;
+  }
+  return values;
+} // ... parse_ascii_values(...)
+
+
+} // namespace
+
+
+DataFile::DataFile(const std::string& filename)
+  : mapping_(nullptr)
+  , mapping_size_(0)
+  , values_(nullptr)
+  , single_precision_(false)
+  , size_(0)
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    DUNE_THROW(Exceptions::spe10_data_file_missing, "could not open '" << filename << "'!");
+  struct stat file_status;
+  if (::fstat(fd, &file_status) != 0) {
+    ::close(fd);
+    DUNE_THROW(Dune::IOError, "could not stat '" << filename << "'!");
+  }
+  const size_t file_size = static_cast<size_t>(file_status.st_size);
+  void* mapping = nullptr;
+  if (file_size > 0) {
+    mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      DUNE_THROW(Dune::IOError, "could not map '" << filename << "' into memory!");
+    }
+  }
+  // the mapping stays valid after closing
+  ::close(fd);
+  const char* data = static_cast<const char*>(mapping);
+  if (is_binary_header(data, file_size)) {
+    BinaryHeader header;
+    std::memcpy(&header, data, sizeof(BinaryHeader));
+    if (header.byte_order_mark != binary_byte_order_mark || header.version != binary_version
+        || (header.value_size != sizeof(double) && header.value_size != sizeof(float))
+        || header.num_values > (file_size - sizeof(BinaryHeader)) / header.value_size) {
+      ::munmap(mapping, file_size);
+      DUNE_THROW(Dune::IOError,
+                 "'" << filename << "' is not a valid binary data file (was it written on a different architecture or "
+                     << "by a different version of convert_to_binary()?)!");
+    }
+    mapping_ = mapping;
+    mapping_size_ = file_size;
+    values_ = data + sizeof(BinaryHeader);
+    single_precision_ = (header.value_size == sizeof(float));
+    size_ = header.num_values;
+    ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+  } else {
+    std::string text;
+    if (mapping != nullptr) {
+      text.assign(data, file_size);
+      ::munmap(mapping, file_size);
+    }
+    ascii_values_ = parse_ascii_values(text, filename);
+    values_ = ascii_values_.data();
+    size_ = ascii_values_.size();
+  }
+} // DataFile(...)
+
+
+DataFile::~DataFile()
+{
+  if (mapping_ != nullptr)
+    ::munmap(mapping_, mapping_size_);
+}
+
+
+void convert_to_binary(const std::string& ascii_filename,
+                       const std::string& binary_filename,
+                       const bool single_precision)
+{
+  const DataFile ascii_file(ascii_filename);
+  if (ascii_file.is_binary())
+    DUNE_THROW(Common::Exceptions::wrong_input_given, "'" << ascii_filename << "' is already a binary data file!");
+  BinaryHeader header;
+  std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+  header.byte_order_mark = binary_byte_order_mark;
+  header.version = binary_version;
+  header.value_size = single_precision ? sizeof(float) : sizeof(double);
+  header.unused = 0;
+  header.num_values = ascii_file.size();
+  std::ofstream binary_file(binary_filename, std::ios::binary | std::ios::trunc);
+  if (!binary_file.is_open())
+    DUNE_THROW(Dune::IOError, "could not open '" << binary_filename << "' for writing!");
+  binary_file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+  if (single_precision) {
+    std::vector<float> values(ascii_file.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      values[ii] = static_cast<float>(ascii_file[ii]);
+    binary_file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  } else {
+    std::vector<double> values(ascii_file.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      values[ii] = ascii_file[ii];
+    binary_file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+  }
+  binary_file.close();
+  if (!binary_file)
+    DUNE_THROW(Dune::IOError, "could not write '" << binary_filename << "'!");
+} // ... convert_to_binary(...)
+
+
+} // namespace Spe10
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
@@ -0,0 +1,91 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_FUNCTIONS_SPE10_DATA_HH
+#define DUNE_XT_FUNCTIONS_SPE10_DATA_HH
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace Spe10 {
+
+
+/**
+ * \brief Read-only access to the values of an SPE10 data file, used by Model1Function and Model2Function.
+ *
+ *        Two formats are understood:
+ *          - the ASCII files as distributed, containing whitespace separated values, which are parsed on construction;
+ *          - the binary format written by convert_to_binary(), which is mapped into memory read-only (so all processes
+ *            on a node share the page cache) and requires no parsing at all.
+ *
+ *        The binary format consists of a 32 byte header (the magic string "DXTSPE10", a byte order mark, the format
+ *        version, the size of each value in bytes and the number of values) followed by the raw float64 or float32
+ *        values in native byte order.
+ */
+class DataFile
+{
+public:
+  /// \throws Exceptions::spe10_data_file_missing if filename cannot be opened, Dune::IOError if it cannot be read
+  explicit DataFile(const std::string& filename);
+
+  DataFile(const DataFile& other) = delete;
+  DataFile& operator=(const DataFile& other) = delete;
+
+  ~DataFile();
+
+  bool is_binary() const
+  {
+    return mapping_ != nullptr;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  double operator[](const size_t ii) const
+  {
+    if (single_precision_)
+      return static_cast<const float*>(values_)[ii];
+    return static_cast<const double*>(values_)[ii];
+  }
+
+private:
+  void* mapping_;
+  size_t mapping_size_;
+  std::vector<double> ascii_values_;
+  const void* values_;
+  bool single_precision_;
+  size_t size_;
+}; // class DataFile
+
+
+/**
+ * \brief Converts the ASCII data file ascii_filename to the binary format understood by DataFile, storing the values
+ *        as float32 if single_precision is true and as float64 otherwise.
+ *
+ *        This is meant to be done once per data file, e.g.
+\code
+Spe10::convert_to_binary(XT::Data::spe10_model2_filename(), "spe10_model2.bin");
+Spe10::Model2Function<E, 3, 3> permeability("spe10_model2.bin", lower_left, upper_right);
+\endcode
+ */
+void convert_to_binary(const std::string& ascii_filename,
+                       const std::string& binary_filename,
+                       const bool single_precision = false);
+
+
+} // namespace Spe10
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_FUNCTIONS_SPE10_DATA_HH
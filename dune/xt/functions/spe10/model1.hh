@@ -18,6 +18,7 @@
 #include <dune/xt/data/paths.hh>
 
 #include "../checkerboard.hh"
+#include "data.hh"
 
 namespace Dune {
 namespace XT {
@@ -68,22 +69,17 @@ private:
       DUNE_THROW(Dune::RangeError, "max (is " << max << ") has to be larger than min (is " << min << ")!");
     const RangeFieldType scale = (max - min) / (internal::model1_max_value - internal::model1_min_value);
     const RangeFieldType shift = min - scale * internal::model1_min_value;
-    // read all the data from the file
-    std::ifstream datafile(filename);
-    if (!datafile.is_open())
-      DUNE_THROW(Exceptions::spe10_data_file_missing, "could not open '" << filename << "'!");
+    // read all the data from the file (either ASCII or binary, see DataFile)
+    const DataFile datafile(filename);
     static const size_t entriesPerDim = model1_x_elements * model1_y_elements * model1_z_elements;
     // create storage (there should be exactly 6000 values in the file, but we only read the first 2000)
-    std::vector<RangeType> data(entriesPerDim, unit_range);
-    double tmp = 0;
-    size_t counter = 0;
-    while (datafile >> tmp && counter < entriesPerDim)
-      data[counter++] *= (tmp * scale) + shift;
-    datafile.close();
-    if (counter != entriesPerDim)
+    if (datafile.size() < entriesPerDim)
       DUNE_THROW(Dune::IOError,
-                 "wrong number of entries in '" << filename << "' (are " << counter << ", should be " << entriesPerDim
-                                                << ")!");
+                 "wrong number of entries in '" << filename << "' (are " << datafile.size() << ", should be at least "
+                                                << entriesPerDim << ")!");
+    std::vector<RangeType> data(entriesPerDim, unit_range);
+    for (size_t ii = 0; ii < entriesPerDim; ++ii)
+      data[ii] *= (datafile[ii] * scale) + shift;
     return data;
   } // ... read_values_from_file(...)
 
@@ -18,6 +18,7 @@
 #include <dune/xt/data/paths.hh>
 
 #include "../checkerboard.hh"
+#include "data.hh"
 
 namespace Dune {
 namespace XT {
@@ -71,46 +72,54 @@ public:
   } // ... static_id(...)
 
 private:
-  static std::vector<RangeType> read_values_from_file(const std::string& filename,
-                                                      const Common::FieldVector<size_t, domain_dim>& number_of_elements)
+  using ValuesInterfaceType = typename BaseType::ValuesInterface;
 
+  template <class F>
+  static std::shared_ptr<const ValuesInterfaceType>
+  read_diagonals_from_file(const std::string& filename,
+                           const Common::FieldVector<size_t, domain_dim>& number_of_elements)
   {
-    // read all the data from the file
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    // read all the data from the file (either ASCII or binary, see DataFile)
+    std::unique_ptr<const DataFile> file;
+    try {
+      file = std::make_unique<const DataFile>(filename);
+    } catch (const Exceptions::spe10_data_file_missing&) {
       DXTC_LOG_ERROR_0 << "The SPE10-permeability data file could not be opened. This file does\n"
                        << "not come with the dune-multiscale repository due to file size. To download it\n"
                        << "execute\n"
                        << "wget http://www.spe.org/web/csp/datasets/por_perm_case2a.zip\n"
                        << "unzip the file and move the file 'spe_perm.dat' to\n"
                        << "dune-multiscale/dune/multiscale/problems/spe10_permeability.dat!\n";
-      DUNE_THROW(IOError, "Data file for Groundwaterflow permeability could not be opened!");
+      throw;
     }
     const size_t entries_per_coordinate =
         number_of_elements[0] /*x*/ * number_of_elements[1] /*y*/ * number_of_elements[2] /*z*/;
-
-    std::vector<double> values_in_file(3 * entries_per_coordinate);
-    double val;
-    file >> val;
-    size_t filecounter = 0;
-    while (!file.eof() && filecounter < 3 * entries_per_coordinate) {
-      values_in_file[filecounter++] = val;
-      file >> val; // sets EOF flag if no value found
-    }
-    file.close();
     /* todo */
-    // if (filecounter != 3366000)
+    // if (file->size() != 3366000)
     //#warning you are not using the entire data file. Use default number_of_elements instead.
+    const size_t num_values = std::min(file->size(), 3 * entries_per_coordinate);
 
-    std::vector<RangeType> data(entries_per_coordinate, RangeType(0));
+    // only the diagonal is stored, see CheckerboardFunction::DiagonalValues
+    std::vector<F> data(domain_dim * entries_per_coordinate, F(0));
 
     for (size_t ii = 0; ii < entries_per_coordinate; ++ii) {
       for (size_t dim = 0; dim < domain_dim; ++dim) {
         const auto idx = ii + dim * entries_per_coordinate;
-        data[ii][dim][dim] = values_in_file[idx];
+        if (idx < num_values)
+          data[ii * domain_dim + dim] = static_cast<F>((*file)[idx]);
       }
     }
-    return data;
+    return std::make_shared<const typename BaseType::template DiagonalValues<F>>(std::move(data));
+  } // ... read_diagonals_from_file(...)
+
+  static std::shared_ptr<const ValuesInterfaceType>
+  read_values_from_file(const std::string& filename,
+                        const Common::FieldVector<size_t, domain_dim>& number_of_elements,
+                        const bool single_precision)
+  {
+    if (single_precision)
+      return read_diagonals_from_file<float>(filename, number_of_elements);
+    return read_diagonals_from_file<R>(filename, number_of_elements);
   }
 
 
@@ -131,15 +140,23 @@ public:
     return config;
   } // ... defaults(...)
 
+  /**
+   * \param single_precision if true, the permeabilities are stored as float (which reduces the memory footprint by
+   *                         another factor of two) and converted to R on binding a local function
+   */
   Model2Function(const std::string& filename,
                  const Common::FieldVector<DomainFieldType, domain_dim>& lower_left,
                  const Common::FieldVector<DomainFieldType, domain_dim>& upper_right,
                  const Common::FieldVector<size_t, domain_dim>& number_of_elements = {internal::model2_x_elements,
                                                                                       internal::model2_y_elements,
                                                                                       internal::model2_z_elements},
-                 const std::string nm = BaseType::static_id())
-    : BaseType(lower_left, upper_right, number_of_elements, read_values_from_file(filename, number_of_elements), nm)
-
+                 const std::string nm = BaseType::static_id(),
+                 const bool single_precision = false)
+    : BaseType(lower_left,
+               upper_right,
+               number_of_elements,
+               read_values_from_file(filename, number_of_elements, single_precision),
+               nm)
   {}
 }; // class Model2Function
 
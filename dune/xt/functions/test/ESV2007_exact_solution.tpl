@@ -13,6 +13,7 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
@@ -111,6 +112,19 @@ TEST_F(ESV2007ExactSolutionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, glo
   }
 }
 
+TEST_F(ESV2007ExactSolutionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate_with_jacobian)
+{
+  FunctionType function(3);
+  for (auto point : {0.25, 0.5, 0.75}) {
+    const DomainType xx(point);
+    RangeReturnType value;
+    DerivativeRangeReturnType jacobian;
+    function.evaluate_with_jacobian(xx, value, jacobian);
+    EXPECT_TRUE(Common::FloatCmp::eq(function.evaluate(xx), value));
+    EXPECT_EQ(function.jacobian(xx), jacobian);
+  }
+}
+
 TEST_F(ESV2007ExactSolutionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable)
 {
   FunctionType default_function(3);
@@ -181,4 +195,26 @@ TEST_F(ESV2007ExactSolutionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, loc
 }
 
 
+TEST_F(ESV2007ExactSolutionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_jacobian)
+{
+  FunctionType function(3);
+  const auto& localizable_function = function.template as_grid_function<ElementType>();
+  auto local_f = localizable_function.local_function();
+  const auto leaf_view = grid_.leaf_view();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f->bind(element);
+    for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+      const auto local_x = quadrature_point.position();
+      std::vector<typename decltype(local_f)::element_type::RangeType> values;
+      std::vector<typename decltype(local_f)::element_type::DerivativeRangeType> jacobians;
+      local_f->evaluate_with_jacobians(local_x, values, jacobians);
+      ASSERT_EQ(size_t(1), values.size());
+      ASSERT_EQ(size_t(1), jacobians.size());
+      EXPECT_TRUE(Common::FloatCmp::eq(local_f->evaluate(local_x), RangeReturnType(values[0])));
+      EXPECT_EQ(local_f->jacobian(local_x), DerivativeRangeReturnType(jacobians[0]));
+    }
+  }
+}
+
+
 {% endfor  %}
@@ -2,6 +2,14 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
@@ -11,6 +19,87 @@
 using namespace Dune::XT;
 
 
+/// The value of the attribute name of the xml tag (or an empty string).
+std::string xml_attribute(const std::string& tag, const std::string& name)
+{
+  const auto begin = tag.find(" " + name + "=\"");
+  if (begin == std::string::npos)
+    return "";
+  const auto value_begin = begin + name.size() + 3;
+  return tag.substr(value_begin, tag.find('"', value_begin) - value_begin);
+}
+
+
+struct VtuPiece
+{
+  size_t num_points = 0;
+  size_t num_cells = 0;
+  std::map<std::string, std::vector<float>> fields; // the point and cell data
+};
+
+
+/**
+ * Reads a .vtu file with raw appended data (as written by ParallelVTUWriter) and checks that the offset of each
+ * DataArray in the header points to the size of the array (given by its type, number of components and the number of
+ * points or cells of the piece), and that the arrays follow each other without gaps up to the end of the appended data.
+ */
+VtuPiece read_appended_vtu(const std::string& filename)
+{
+  VtuPiece piece;
+  std::ifstream file(filename, std::ios::binary);
+  EXPECT_TRUE(file.is_open()) << "could not open " << filename;
+  const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const std::string appended_data_tag = "<AppendedData encoding=\"raw\">\n_";
+  const auto appended_data_tag_begin = content.find(appended_data_tag);
+  if (appended_data_tag_begin == std::string::npos) {
+    ADD_FAILURE() << "no raw appended data in " << filename;
+    return piece;
+  }
+  const size_t data_start = appended_data_tag_begin + appended_data_tag.size();
+  const auto piece_begin = content.find("<Piece ");
+  const std::string piece_tag = content.substr(piece_begin, content.find('>', piece_begin) - piece_begin);
+  piece.num_points = std::stoul(xml_attribute(piece_tag, "NumberOfPoints"));
+  piece.num_cells = std::stoul(xml_attribute(piece_tag, "NumberOfCells"));
+  const auto cell_data_begin = content.find("<CellData>");
+  const auto cell_data_end = content.find("</CellData>");
+  const auto points_begin = content.find("<Points>");
+  size_t expected_offset = 0;
+  int64_t last_cell_offset = -1;
+  for (auto tag_begin = content.find("<DataArray "); tag_begin < data_start;
+       tag_begin = content.find("<DataArray ", tag_begin + 1)) {
+    const std::string tag = content.substr(tag_begin, content.find('>', tag_begin) - tag_begin);
+    const auto type = xml_attribute(tag, "type");
+    const auto name = xml_attribute(tag, "Name");
+    const auto ncomps_string = xml_attribute(tag, "NumberOfComponents");
+    const size_t ncomps = ncomps_string.empty() ? 1 : std::stoul(ncomps_string);
+    const bool is_cell_array = (tag_begin > cell_data_begin && tag_begin < cell_data_end) || name == "offsets"
+                               || name == "types";
+    const size_t entry_size = (type == "Float32") ? sizeof(float) : (type == "Int64") ? sizeof(int64_t) : 1;
+    const size_t expected_size = (is_cell_array ? piece.num_cells : piece.num_points) * ncomps * entry_size;
+    const size_t offset = std::stoul(xml_attribute(tag, "offset"));
+    EXPECT_EQ(expected_offset, offset) << "DataArray " << name;
+    if (data_start + offset + sizeof(uint64_t) + expected_size > content.size()) {
+      ADD_FAILURE() << "DataArray " << name << " exceeds " << filename;
+      return piece;
+    }
+    uint64_t size = 0;
+    std::memcpy(&size, content.data() + data_start + offset, sizeof(uint64_t));
+    EXPECT_EQ(expected_size, size) << "DataArray " << name;
+    const char* data = content.data() + data_start + offset + sizeof(uint64_t);
+    if (tag_begin < points_begin) {
+      auto& values = piece.fields[name];
+      values.resize(expected_size / sizeof(float));
+      std::memcpy(values.data(), data, expected_size);
+    } else if (name == "offsets" && piece.num_cells > 0)
+      std::memcpy(&last_cell_offset, data + expected_size - sizeof(int64_t), sizeof(int64_t));
+    expected_offset = offset + sizeof(uint64_t) + expected_size;
+  }
+  EXPECT_EQ(int64_t(piece.num_points), last_cell_offset);
+  EXPECT_EQ("\n  </AppendedData>\n</VTKFile>\n", content.substr(data_start + expected_offset));
+  return piece;
+} // ... read_appended_vtu(...)
+
+
 {% for GRIDNAME, GRID, r, rC in config['types'] %}
 
 struct CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}} : public ::testing::Test
@@ -97,6 +186,113 @@ TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_visualiz
   function_all.visualize(leaf_view, "test__AllDomain__CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}__is_visualizable");
 }
 
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_visualizable_in_parallel)
+{
+  const auto leaf_view = grid_.leaf_view();
+  DomainType lower_left(-1.);
+  DomainType upper_right(1.);
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  std::vector<RangeType> values;
+  for (size_t dd = 0; dd < d; ++dd)
+      num_squares *= num_elements[dd];
+  for (size_t ii = 0; ii < num_squares; ++ii) {
+      RangeType entry(ii+1);
+      values.emplace_back(entry);
+  }
+  FunctionType function(lower_left, upper_right, num_elements, values);
+  FunctionType function_all(lower_left, upper_right, num_elements, values, "function_all");
+  Dune::XT::Functions::ParallelVTUWriter<std::decay_t<decltype(leaf_view)>> writer(leaf_view, /*num_threads=*/3, /*chunk_size=*/5);
+  writer.add_function(function);
+  writer.add_function(function, "again");
+{% if r == 1 and rC == 1 %}
+  writer.add_gradient(function, "gradient");
+{% endif %}
+  const std::string path =
+      "test__CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}__is_visualizable_in_parallel";
+  writer.write(path);
+  const auto& comm = leaf_view.comm();
+  const auto piece = read_appended_vtu((comm.size() == 1) ? path + ".vtu"
+                                                          : path + "-p" + Common::to_string(comm.rank()) + ".vtu");
+  size_t num_cells = 0;
+  size_t num_points = 0;
+  for (auto&& element : Dune::elements(leaf_view, Dune::Partitions::interior)) {
+    ++num_cells;
+    num_points += element.geometry().corners();
+  }
+  EXPECT_EQ(num_cells, piece.num_cells);
+  EXPECT_EQ(num_points, piece.num_points);
+  ASSERT_EQ(size_t(1), piece.fields.count(function.name()));
+  ASSERT_EQ(size_t(1), piece.fields.count("again"));
+  const auto& function_values = piece.fields.at(function.name());
+  // the default visualizer writes the entries of vectors and the frobenius norm of matrices
+  EXPECT_EQ(num_points * ((rC == 1) ? r : 1), function_values.size());
+  EXPECT_EQ(function_values, piece.fields.at("again"));
+  for (const auto& value : function_values)
+    EXPECT_GE(value, 1.f); // all values of the checkerboard are at least 1
+{% if r == 1 and rC == 1 %}
+  ASSERT_EQ(size_t(1), piece.fields.count("gradient"));
+  EXPECT_EQ(num_cells * d, piece.fields.at("gradient").size());
+  for (const auto& value : piece.fields.at("gradient"))
+    EXPECT_EQ(0.f, value);
+{% endif %}
+  if (comm.size() > 1 && comm.rank() == 0) {
+    std::ifstream collection_file(path + ".pvtu");
+    ASSERT_TRUE(collection_file.is_open());
+    const std::string collection((std::istreambuf_iterator<char>(collection_file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, collection.find("<PDataArray type=\"Float32\" Name=\"again\""));
+    for (int pp = 0; pp < comm.size(); ++pp)
+      EXPECT_NE(std::string::npos,
+                collection.find("<Piece Source=\"" + path + "-p" + Common::to_string(pp) + ".vtu\"/>"));
+  }
+{% if r == 1 and rC == 1 %}
+  Dune::XT::Functions::visualize(leaf_view,
+                                 "test__CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}__is_visualizable_with_others",
+                                 function,
+                                 Dune::XT::Functions::gradient_of(function),
+                                 function_all);
+{% else %}
+  Dune::XT::Functions::visualize(leaf_view,
+                                 "test__CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}__is_visualizable_with_others",
+                                 function,
+                                 function_all);
+{% endif %}
+}
+
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, visualization_adapter_evaluates_like_local_function)
+{
+  const auto leaf_view = grid_.leaf_view();
+  using GridViewType = std::decay_t<decltype(leaf_view)>;
+  DomainType lower_left(-1.);
+  DomainType upper_right(1.);
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  std::vector<RangeType> values;
+  for (size_t dd = 0; dd < d; ++dd)
+      num_squares *= num_elements[dd];
+  for (size_t ii = 0; ii < num_squares; ++ii) {
+      RangeType entry(ii+1);
+      values.emplace_back(entry);
+  }
+  FunctionType function(lower_left, upper_right, num_elements, values);
+  Dune::XT::Functions::VisualizationAdapter<GridViewType, r, rC, double> adapter(function);
+  Dune::XT::Functions::DefaultVisualizer<r, rC, double> visualizer;
+  auto local_f = function.local_function();
+  // alternate between elements and points, as VTKWriter does
+  for (size_t run = 0; run < 2; ++run) {
+    for (auto&& element : Dune::elements(leaf_view)) {
+      local_f->bind(element);
+      const auto& reference_element = Dune::ReferenceElements<double, d>::general(element.type());
+      for (int ii = 0; ii < reference_element.size(d); ++ii) {
+        const auto local_x = reference_element.position(ii, d);
+        const auto expected_value = local_f->evaluate(local_x);
+        for (int comp = 0; comp < adapter.ncomps(); ++comp)
+          EXPECT_EQ(visualizer.evaluate(comp, expected_value), adapter.evaluate(comp, element, local_x));
+      }
+    }
+  }
+}
+
 TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable)
 {
   DomainType lower_left(0.);
@@ -120,6 +316,30 @@ TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable
     local_f->bind(element);
 }
 
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, static_local_function_evaluates_like_local_function)
+{
+  static_assert(Functions::is_static_grid_function<FunctionType>::value, "");
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  std::vector<RangeType> values;
+  for (size_t dd = 0; dd < d; ++dd)
+      num_squares *= num_elements[dd];
+  for (size_t ii = 0; ii < num_squares; ++ii) {
+      RangeType entry(ii+1);
+      values.emplace_back(entry);
+  }
+  FunctionType function(DomainType(-1.), DomainType(1.), num_elements, values);
+  auto static_local_f = function.static_local_function();
+  auto local_f = function.local_function();
+  const auto leaf_view = grid_.leaf_view();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    static_local_f->bind(element);
+    local_f->bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(local_f->evaluate(local_x), static_local_f->evaluate(local_x));
+  }
+}
+
 TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_order)
 {
   const auto leaf_view = grid_.leaf_view();
@@ -198,6 +418,157 @@ TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evalu
 }
 
 
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_precomputed_subdomains)
+{
+  const auto leaf_view = grid_.leaf_view();
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  std::vector<RangeType> values;
+  for (size_t dd = 0; dd < d; ++dd)
+    num_squares *= num_elements[dd];
+  for (size_t ii = 0; ii < num_squares; ++ii)
+    values.emplace_back(RangeType(ii + 1));
+  for (auto ll : {-1., -0.5}) {
+    const DomainType lower_left(ll);
+    for (auto ur : {1., 0.5}) {
+      const DomainType upper_right(ur);
+      const FunctionType function(lower_left, upper_right, num_elements, values);
+      FunctionType precomputed_function(lower_left, upper_right, num_elements, values);
+      precomputed_function.precompute_subdomains(leaf_view);
+      auto local_f = function.local_function();
+      auto precomputed_local_f = precomputed_function.local_function();
+      for (auto&& element : Dune::elements(leaf_view)) {
+        local_f->bind(element);
+        precomputed_local_f->bind(element);
+        const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+        EXPECT_EQ(local_f->evaluate(local_x), precomputed_local_f->evaluate(local_x));
+        EXPECT_EQ(function.subdomain(element), precomputed_function.subdomain(element));
+      }
+    }
+  }
+}
+
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, precomputed_subdomains_are_replaced_after_refinement)
+{
+  auto grid = Dune::XT::Grid::make_cube_grid<GridType>(-1., 1., 4);
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  std::vector<RangeType> values;
+  for (size_t dd = 0; dd < d; ++dd)
+    num_squares *= num_elements[dd];
+  for (size_t ii = 0; ii < num_squares; ++ii)
+    values.emplace_back(RangeType(ii + 1));
+  const DomainType lower_left(-0.5);
+  const DomainType upper_right(1.);
+  const FunctionType function(lower_left, upper_right, num_elements, values);
+  FunctionType precomputed_function(lower_left, upper_right, num_elements, values);
+  precomputed_function.precompute_subdomains(grid.leaf_view());
+  grid.grid().globalRefine(1);
+  const auto leaf_view = grid.leaf_view();
+  precomputed_function.precompute_subdomains(leaf_view);
+  auto local_f = function.local_function();
+  auto precomputed_local_f = precomputed_function.local_function();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f->bind(element);
+    precomputed_local_f->bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(local_f->evaluate(local_x), precomputed_local_f->evaluate(local_x));
+    EXPECT_EQ(function.subdomain(element), precomputed_function.subdomain(element));
+  }
+}
+
+{% if r == rC %}
+
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_diagonal_values)
+{
+  const auto leaf_view = grid_.leaf_view();
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  for (size_t dd = 0; dd < d; ++dd)
+    num_squares *= num_elements[dd];
+  std::vector<float> diagonal_entries;
+  std::vector<RangeType> values(num_squares, RangeType(0.));
+  for (size_t ii = 0; ii < num_squares; ++ii) {
+    for (size_t rr = 0; rr < r; ++rr) {
+      diagonal_entries.emplace_back(0.5f * (ii * r + rr + 1));
+{% if r == 1 %}
+      values[ii][rr] = diagonal_entries.back();
+{% else %}
+      values[ii][rr][rr] = diagonal_entries.back();
+{% endif %}
+    }
+  }
+  const DomainType lower_left(-1.);
+  const DomainType upper_right(0.5);
+  const FunctionType function(lower_left, upper_right, num_elements, values);
+  const FunctionType diagonal_function(
+      lower_left,
+      upper_right,
+      num_elements,
+      std::make_shared<const typename FunctionType::template DiagonalValues<float>>(diagonal_entries));
+  EXPECT_EQ(num_squares, diagonal_function.subdomains());
+  auto local_f = function.local_function();
+  auto diagonal_local_f = diagonal_function.local_function();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f->bind(element);
+    diagonal_local_f->bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(local_f->evaluate(local_x), diagonal_local_f->evaluate(local_x));
+  }
+}
+
+{% endif %}
+
+TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_contiguous_values)
+{
+  const auto leaf_view = grid_.leaf_view();
+  Common::FieldVector<size_t, d> num_elements(2.);
+  size_t num_squares = 1;
+  for (size_t dd = 0; dd < d; ++dd)
+    num_squares *= num_elements[dd];
+  std::vector<double> entries;
+  std::vector<RangeType> values(num_squares, RangeType(0.));
+  for (size_t ii = 0; ii < num_squares; ++ii) {
+    for (size_t rr = 0; rr < r; ++rr) {
+      for (size_t cc = 0; cc < rC; ++cc) {
+        entries.emplace_back(0.5 * entries.size() + 1.);
+{% if rC == 1 %}
+        values[ii][rr] = entries.back();
+{% else %}
+        values[ii][rr][cc] = entries.back();
+{% endif %}
+      }
+    }
+  }
+  const DomainType lower_left(-1.);
+  const DomainType upper_right(0.5);
+  const FunctionType function(lower_left, upper_right, num_elements, values);
+  using ContiguousValuesType = typename FunctionType::ContiguousValues;
+  const FunctionType owning_function(
+      lower_left, upper_right, num_elements, std::make_shared<const ContiguousValuesType>(entries));
+  const auto referenced_entries = std::make_shared<const std::vector<double>>(entries);
+  const FunctionType referencing_function(
+      lower_left,
+      upper_right,
+      num_elements,
+      std::make_shared<const ContiguousValuesType>(
+          referenced_entries->data(), referenced_entries->size(), referenced_entries));
+  EXPECT_EQ(num_squares, owning_function.subdomains());
+  EXPECT_EQ(num_squares, referencing_function.subdomains());
+  auto local_f = function.local_function();
+  auto owning_local_f = owning_function.local_function();
+  auto referencing_local_f = referencing_function.local_function();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f->bind(element);
+    owning_local_f->bind(element);
+    referencing_local_f->bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(local_f->evaluate(local_x), owning_local_f->evaluate(local_x));
+    EXPECT_EQ(local_f->evaluate(local_x), referencing_local_f->evaluate(local_x));
+  }
+  EXPECT_THROW(ContiguousValuesType(std::vector<double>(r * rC + 1, 0.)), Common::Exceptions::shapes_do_not_match);
+}
+
 TEST_F(CheckerboardFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_jacobian)
 {
   const auto leaf_view = grid_.leaf_view();
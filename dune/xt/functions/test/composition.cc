@@ -0,0 +1,72 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Has to come first, includes the config.h!
+
+#include <type_traits>
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/functions/base/composition.hh>
+#include <dune/xt/functions/checkerboard.hh>
+#include <dune/xt/functions/generic/function.hh>
+#include <dune/xt/functions/grid-function.hh>
+
+using namespace Dune;
+using namespace Dune::XT::Functions;
+
+using G = CUBEGRID_2D;
+using E = XT::Grid::extract_entity_t<G>;
+static const constexpr size_t d = G::dimension;
+
+// from here on, the code should work for any E and d to allow for grid parametrization
+
+
+GTEST_TEST(CompositionFunction, evaluate_at_points_coincides_with_pointwise_evaluation)
+{
+  auto inner_grid = XT::Grid::make_cube_grid<G>(0., 1., 4);
+  auto outer_grid = XT::Grid::make_cube_grid<G>(0., 1., 3);
+  const auto inner_grid_view = inner_grid.leaf_view();
+  const auto outer_grid_view = outer_grid.leaf_view();
+  using OuterGridViewType = std::decay_t<decltype(outer_grid_view)>;
+  // maps [0, 1]^d onto itself, but the elements of the inner grid not onto those of the outer grid
+  using InnerFunctionType = GenericFunction<d, d>;
+  const InnerFunctionType inner_function(2, [](const auto& xx, const auto& /*param*/) {
+    typename InnerFunctionType::RangeReturnType value(xx);
+    value[0] = xx[0] * xx[0];
+    return value;
+  });
+  const GridFunction<E, d> inner(inner_function);
+  std::vector<FieldVector<double, 1>> values;
+  size_t num_subdomains = 1;
+  for (size_t dd = 0; dd < d; ++dd)
+    num_subdomains *= 3;
+  for (size_t ii = 0; ii < num_subdomains; ++ii)
+    values.emplace_back(ii + 1.);
+  const CheckerboardFunction<E> outer(
+      FieldVector<double, d>(0.), FieldVector<double, d>(1.), FieldVector<size_t, d>(3), values);
+  const CompositionFunction<GridFunction<E, d>, CheckerboardFunction<E>, OuterGridViewType> composition(
+      inner, outer, outer_grid_view);
+  auto pointwise_local_function = composition.local_function();
+  auto batched_local_function = composition.local_function();
+  for (auto&& element : elements(inner_grid_view)) {
+    pointwise_local_function->bind(element);
+    batched_local_function->bind(element);
+    const auto& quadrature = QuadratureRules<double, d>::rule(element.type(), 3);
+    std::vector<double> batched_values(quadrature.size());
+    batched_local_function->evaluate_at_points(quadrature, batched_values.data());
+    for (size_t pp = 0; pp < quadrature.size(); ++pp) {
+      const auto expected_value = pointwise_local_function->evaluate(quadrature[pp].position());
+      EXPECT_EQ(expected_value[0], batched_values[pp])
+          << "element center: " << element.geometry().center() << "\n   point: " << quadrature[pp].position();
+    }
+  }
+}
@@ -1,5 +1,7 @@
 #include <dune/xt/common/test/main.hxx>
 
+#include <thread>
+
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
@@ -106,6 +108,24 @@ TEST_F(ConstantFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable)
   }
 }
 
+TEST_F(ConstantFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, as_grid_function_is_cached_per_function)
+{
+  FunctionType function(1.);
+  const auto& localizable_function = function.template as_grid_function<ElementType>();
+  EXPECT_EQ(&localizable_function, &function.template as_grid_function<ElementType>());
+  EXPECT_EQ(&localizable_function, &function.as_grid_function(grid_.leaf_view()));
+  const FunctionType copied_function(function);
+  const auto& copied_localizable_function = copied_function.template as_grid_function<ElementType>();
+  EXPECT_NE(&localizable_function, &copied_localizable_function);
+  auto local_f = copied_localizable_function.local_function();
+  const auto leaf_view = grid_.leaf_view();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f->bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(RangeReturnType(1.), local_f->evaluate(local_x));
+  }
+}
+
 TEST_F(ConstantFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_order)
 {
   const int expected_order = 0;
@@ -214,6 +234,46 @@ TEST_F(ConstantGridFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable
   }
 }
 
+TEST_F(ConstantGridFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, thread_local_function_is_reused_within_each_thread)
+{
+  FunctionType function(1.);
+  auto& local_f = function.thread_local_function();
+  EXPECT_EQ(&local_f, &function.thread_local_function());
+  const auto leaf_view = grid_.leaf_view();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    local_f.bind(element);
+    const auto& local_x = Dune::ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    EXPECT_EQ(RangeReturnType(1.), local_f.evaluate(local_x));
+  }
+  const auto* local_f_of_other_thread = &local_f;
+  std::thread([&]() { local_f_of_other_thread = &function.thread_local_function(); }).join();
+  EXPECT_NE(&local_f, local_f_of_other_thread);
+  const FunctionType copied_function(function);
+  EXPECT_NE(&local_f, &copied_function.thread_local_function());
+}
+
+TEST_F(ConstantGridFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, static_local_function_evaluates_like_local_function)
+{
+  static_assert(Functions::is_static_grid_function<FunctionType>::value, "");
+  static_assert(!Functions::is_static_grid_function<typename FunctionType::LocalFunctionType>::value, "");
+  FunctionType function(RangeReturnType(3.));
+  auto static_local_f = Functions::static_local_function(function);
+  static_assert(std::is_same<decltype(static_local_f),
+                             std::unique_ptr<typename FunctionType::StaticLocalFunctionType>>::value,
+                "");
+  auto local_f = function.local_function();
+  const auto leaf_view = grid_.leaf_view();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    static_local_f->bind(element);
+    local_f->bind(element);
+    for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+      const auto local_x = quadrature_point.position();
+      EXPECT_EQ(local_f->evaluate(local_x), static_local_f->evaluate(local_x));
+      EXPECT_EQ(local_f->jacobian(local_x), static_local_f->jacobian(local_x));
+    }
+  }
+}
+
 TEST_F(ConstantGridFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_order)
 {
   const int expected_order = 0;
@@ -0,0 +1,168 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Has to come first, includes the config.h!
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/functions/base/element-function-set-tabulation.hh>
+#include <dune/xt/functions/interfaces/element-functions.hh>
+
+using namespace Dune;
+using namespace Dune::XT::Functions;
+
+using G = CUBEGRID_2D;
+using E = XT::Grid::extract_entity_t<G>;
+static const constexpr size_t d = G::dimension;
+static const constexpr size_t r = 2;
+
+// from here on, the code should work for any E and d to allow for grid parametrization
+
+
+/**
+ * The functions 1, x_0, ..., x_{d - 1} (in reference coordinates), times (1, ..., r).
+ */
+template <bool element_invariant>
+class TestFunctionSet : public ElementFunctionSetInterface<E, r>
+{
+  using BaseType = ElementFunctionSetInterface<E, r>;
+
+public:
+  using typename BaseType::DerivativeRangeType;
+  using typename BaseType::DomainType;
+  using typename BaseType::ElementType;
+  using typename BaseType::RangeType;
+
+protected:
+  void post_bind(const ElementType& /*element*/) override final {}
+
+public:
+  size_t size(const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    return d + 1;
+  }
+
+  size_t max_size(const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    return d + 1;
+  }
+
+  int order(const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    return 1;
+  }
+
+  void evaluate(const DomainType& point_in_reference_element,
+                std::vector<RangeType>& result,
+                const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    if (result.size() < d + 1)
+      result.resize(d + 1);
+    for (size_t ii = 0; ii < d + 1; ++ii)
+      for (size_t rr = 0; rr < r; ++rr)
+        result[ii][rr] = (rr + 1.) * ((ii == 0) ? 1. : point_in_reference_element[ii - 1]);
+  }
+
+  void jacobians(const DomainType& point_in_reference_element,
+                 std::vector<DerivativeRangeType>& result,
+                 const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    if (result.size() < d + 1)
+      result.resize(d + 1);
+    const auto J_inv_T = this->element().geometry().jacobianInverseTransposed(point_in_reference_element);
+    for (size_t ii = 0; ii < d + 1; ++ii) {
+      for (size_t rr = 0; rr < r; ++rr) {
+        FieldVector<double, d> reference_gradient(0.);
+        if (ii > 0)
+          reference_gradient[ii - 1] = rr + 1.;
+        J_inv_T.mv(reference_gradient, result[ii][rr]);
+      }
+    }
+  }
+
+  bool is_element_invariant(const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    return element_invariant;
+  }
+}; // class TestFunctionSet
+
+
+GTEST_TEST(ElementFunctionSetInterface, evaluate_at_points)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4);
+  const auto grid_view = grid.leaf_view();
+  TestFunctionSet<false> function_set;
+  for (auto&& element : elements(grid_view)) {
+    function_set.bind(element);
+    const auto& quadrature = QuadratureRules<double, d>::rule(element.type(), 2);
+    const size_t num_points = quadrature.size();
+    for (auto layout : {SetEvaluationLayout::point_function_component, SetEvaluationLayout::function_point_component}) {
+      std::vector<double> values(num_points * (d + 1) * r);
+      std::vector<double> jacobians(num_points * (d + 1) * r * d);
+      function_set.evaluate_at_points(quadrature, values.data(), layout);
+      function_set.jacobians_at_points(quadrature, jacobians.data(), layout);
+      for (size_t pp = 0; pp < num_points; ++pp) {
+        const auto expected_values = function_set.evaluate_set(quadrature[pp].position());
+        const auto expected_jacobians = function_set.jacobians_of_set(quadrature[pp].position());
+        for (size_t ii = 0; ii < d + 1; ++ii) {
+          const size_t index = set_evaluation_index(layout, num_points, d + 1, pp, ii);
+          for (size_t rr = 0; rr < r; ++rr) {
+            EXPECT_EQ(expected_values[ii][rr], values[index * r + rr]);
+            for (size_t dd = 0; dd < d; ++dd)
+              EXPECT_EQ(expected_jacobians[ii][rr][dd], jacobians[(index * r + rr) * d + dd]);
+          }
+        }
+      }
+    }
+  }
+}
+
+GTEST_TEST(ElementFunctionSetTabulation, reuses_element_invariant_sets_on_affine_elements)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4);
+  const auto grid_view = grid.leaf_view();
+  TestFunctionSet<true> function_set;
+  ElementFunctionSetTabulation<E, r> tabulation(function_set, SetEvaluationLayout::function_point_component);
+  for (auto&& element : elements(grid_view)) {
+    function_set.bind(element);
+    const auto& quadrature = QuadratureRules<double, d>::rule(element.type(), 2);
+    std::vector<double> expected_values(quadrature.size() * (d + 1) * r);
+    std::vector<double> expected_jacobians(quadrature.size() * (d + 1) * r * d);
+    function_set.evaluate_at_points(quadrature, expected_values.data(), tabulation.layout());
+    function_set.jacobians_at_points(quadrature, expected_jacobians.data(), tabulation.layout());
+    const auto& values = tabulation.values(quadrature);
+    ASSERT_EQ(expected_values.size(), values.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      EXPECT_DOUBLE_EQ(expected_values[ii], values[ii]);
+    const auto& jacobians = tabulation.jacobians(quadrature);
+    ASSERT_EQ(expected_jacobians.size(), jacobians.size());
+    for (size_t ii = 0; ii < jacobians.size(); ++ii)
+      EXPECT_DOUBLE_EQ(expected_jacobians[ii], jacobians[ii]);
+  }
+  // the values and jacobians have only been computed on the first element
+  EXPECT_EQ(size_t(2), tabulation.num_evaluations());
+}
+
+GTEST_TEST(ElementFunctionSetTabulation, evaluates_other_sets_on_each_element)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4);
+  const auto grid_view = grid.leaf_view();
+  TestFunctionSet<false> function_set;
+  ElementFunctionSetTabulation<E, r> tabulation(function_set);
+  size_t num_elements = 0;
+  for (auto&& element : elements(grid_view)) {
+    function_set.bind(element);
+    const auto& quadrature = QuadratureRules<double, d>::rule(element.type(), 2);
+    EXPECT_EQ(quadrature.size() * (d + 1) * r, tabulation.values(quadrature).size());
+    EXPECT_EQ(quadrature.size() * (d + 1) * r * d, tabulation.jacobians(quadrature).size());
+    ++num_elements;
+  }
+  EXPECT_EQ(2 * num_elements, tabulation.num_evaluations());
+}
@@ -6,7 +6,9 @@
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
 
+#include <dune/xt/functions/affinely-decomposed.hh>
 #include <dune/xt/functions/expression/parametric.hh>
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/common/parameter.hh>
 
 
@@ -142,4 +144,120 @@ TEST_F(ParametricExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, loc
   }
 }
 
+TEST_F(ParametricExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, with_parameter_evaluates_like_evaluate)
+{
+  const RangeExpressionType expr(std::string("sin(x[0]t_)"));
+  FunctionType function("x", {"t_", 1}, expr, 3);
+  for (auto vv : {-10., 3., 17., 41.}) {
+    const auto bound_function = function.with_parameter({"t_", vv});
+    EXPECT_FALSE(bound_function->is_parametric());
+    EXPECT_EQ(function.order(), bound_function->order());
+    const typename FunctionType::ParameterBoundExpressionFunction static_bound_function(function, {"t_", vv});
+    for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+      const DomainType xx(point);
+      const auto expected_value = function.evaluate(xx, {"t_", vv});
+      EXPECT_EQ(expected_value, bound_function->evaluate(xx));
+      EXPECT_EQ(expected_value, static_bound_function.evaluate(xx));
+    }
+  }
+}
+
+TEST_F(ParametricExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_bound_parameter)
+{
+  const auto leaf_view = grid_.leaf_view();
+
+  const RangeExpressionType expr(std::string("sin(x[0]t_)"));
+  FunctionType function("x", {"t_", 1}, expr, 3);
+  const auto& localizable_function = function.template as_grid_function<ElementType>();
+  auto local_f = localizable_function.local_function();
+  for (auto vv : {-10., 3., 17., 41.}) {
+    local_f->bind_parameter({"t_", vv});
+    for (auto&& element : Dune::elements(leaf_view)) {
+      const auto geometry = element.geometry();
+      local_f->bind(element);
+      for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+        const auto local_x = quadrature_point.position();
+        const RangeReturnType expected_value(sin(geometry.global(local_x)[0] * vv));
+        EXPECT_EQ(expected_value, local_f->evaluate(local_x));
+        // an explicitly given parameter takes precedence
+        EXPECT_EQ(function.evaluate(geometry.global(local_x), {"t_", 1.}), local_f->evaluate(local_x, {"t_", 1.}));
+      }
+    }
+  }
+}
+
+TEST_F(ParametricExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, affine_decomposition)
+{
+  const RangeExpressionType expr(std::string("sin(x[0])+t_*x[0]*x[0]"));
+  FunctionType function("x", {"t_", 1}, expr, 3);
+  const auto decomposition = function.affine_decomposition();
+  EXPECT_EQ(size_t(2), decomposition.num_components());
+  EXPECT_EQ(function.order(), decomposition.order());
+  std::vector<RangeReturnType> component_values;
+  for (auto vv : {-10., 3., 17., 41.}) {
+    const auto coefficients = decomposition.coefficients({"t_", vv});
+    EXPECT_EQ(1., coefficients[0]);
+    EXPECT_EQ(vv, coefficients[1]);
+    const auto bound_decomposition = decomposition.with_parameter({"t_", vv});
+    for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+      const DomainType xx(point);
+      const auto expected_value = function.evaluate(xx, {"t_", vv});
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_value, decomposition.evaluate(xx, {"t_", vv})));
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_value, bound_decomposition->evaluate(xx)));
+      decomposition.evaluate_components(xx, component_values);
+      ASSERT_EQ(size_t(2), component_values.size());
+      EXPECT_TRUE(Common::FloatCmp::eq(RangeReturnType(sin(point)), component_values[0]));
+      EXPECT_TRUE(Common::FloatCmp::eq(RangeReturnType(point * point), component_values[1]));
+    }
+  }
+  // the component without t_ is 0/(2+x[0]), which vanishes identically and is left out
+  const RangeExpressionType quotient_expr(std::string("t_/(2+x[0])"));
+  FunctionType quotient_function("x", {"t_", 1}, quotient_expr, 3);
+  const auto quotient_decomposition = quotient_function.affine_decomposition();
+  EXPECT_EQ(size_t(1), quotient_decomposition.num_components());
+  for (auto vv : {-10., 3., 17., 41.}) {
+    EXPECT_EQ(vv, quotient_decomposition.coefficients({"t_", vv})[0]);
+    for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+      const DomainType xx(point);
+      EXPECT_TRUE(Common::FloatCmp::eq(quotient_function.evaluate(xx, {"t_", vv}),
+                                       quotient_decomposition.evaluate(xx, {"t_", vv})));
+    }
+  }
+  // not affine in t_
+  const RangeExpressionType non_affine_expr(std::string("sin(x[0]*t_)"));
+  FunctionType non_affine_function("x", {"t_", 1}, non_affine_expr, 3);
+  EXPECT_THROW(non_affine_function.affine_decomposition(), Functions::Exceptions::wrong_input_given);
+}
+
+TEST_F(ParametricExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, affinely_decomposed_grid_function)
+{
+  const auto leaf_view = grid_.leaf_view();
+
+  const RangeExpressionType expr(std::string("sin(x[0])+t_*x[0]*x[0]"));
+  FunctionType function("x", {"t_", 1}, expr, 3);
+  const auto decomposition = function.affine_decomposition();
+  Functions::AffinelyDecomposedGridFunction<ElementType, r, rC> grid_function({"t_", 1});
+  grid_function.add(decomposition.component(0).template as_grid_function<ElementType>());
+  grid_function.add(decomposition.component(1).template as_grid_function<ElementType>(),
+                    [](const Common::Parameter& param) { return param.get("t_")[0]; });
+  auto local_f = grid_function.static_local_function();
+  std::vector<RangeReturnType> component_values;
+  for (auto vv : {-10., 3., 17., 41.}) {
+    local_f->bind_parameter({"t_", vv});
+    for (auto&& element : Dune::elements(leaf_view)) {
+      const auto geometry = element.geometry();
+      local_f->bind(element);
+      EXPECT_EQ(function.order(), local_f->order());
+      for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+        const auto local_x = quadrature_point.position();
+        const auto expected_value = function.evaluate(geometry.global(local_x), {"t_", vv});
+        EXPECT_TRUE(Common::FloatCmp::eq(expected_value, local_f->evaluate(local_x)));
+        EXPECT_TRUE(Common::FloatCmp::eq(expected_value, local_f->evaluate(local_x, {"t_", vv})));
+        local_f->evaluate_components(local_x, component_values);
+        EXPECT_EQ(size_t(2), component_values.size());
+      }
+    }
+  }
+}
+
 {% endfor  %}
@@ -2,11 +2,17 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
 
 #include <dune/xt/functions/expression.hh>
+#include <dune/xt/functions/expression/mathexpr.hh>
 
 using namespace Dune::XT;
 
@@ -146,6 +152,32 @@ TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evalua
 }
 
 
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate_concurrently)
+{
+  RangeExpressionType expr(std::string(""));
+  for (size_t rr = 0; rr < r; ++rr)
+    expr[rr] = "exp(x[0])+sin(x[0])+" + Common::to_string(rr) + "*x[0]";
+  const FunctionType function("x", expr, 4);
+  std::vector<size_t> failures(4, 0);
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < failures.size(); ++tt)
+    threads.emplace_back([&, tt]() {
+      for (size_t ii = 0; ii < 1000; ++ii) {
+        const double point = -1. + 2. * double(ii) / 1000. + 0.1 * double(tt);
+        const DomainType xx(point);
+        const auto actual_value = function.evaluate(xx);
+        for (size_t rr = 0; rr < r; ++rr)
+          if (Common::FloatCmp::ne(actual_value[rr], exp(point) + sin(point) + double(rr) * point))
+            ++failures[tt];
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+  for (const auto& failure : failures)
+    EXPECT_EQ(size_t(0), failure);
+}
+
+
 TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_jacobian)
 {
   // Constant functions
@@ -184,6 +216,165 @@ TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_jacobi
   }
 }
 
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate_and_jacobian_of_many_points)
+{
+  RangeExpressionType expr(std::string(""));
+  DerivativeRangeExpressionType grad(std::string("0"));
+  for (size_t rr = 0; rr < r; ++rr) {
+    expr[rr] = "exp(x[0])+sin(x[0])+" + Common::to_string(rr) + "*x[0]";
+    grad[rr][0] = "exp(x[0])+cos(x[0])+" + Common::to_string(rr);
+  }
+  const FunctionType function("x", expr, grad, 4);
+  // more points than fit into one block
+  std::vector<DomainType> points;
+  for (size_t ii = 0; ii < 150; ++ii)
+    points.emplace_back(-1. + 2. * double(ii) / 150.);
+  std::vector<RangeReturnType> values;
+  function.evaluate(points, values);
+  std::vector<DerivativeRangeReturnType> jacobians;
+  function.jacobian(points, jacobians);
+  ASSERT_EQ(points.size(), values.size());
+  ASSERT_EQ(points.size(), jacobians.size());
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    EXPECT_EQ(function.evaluate(points[ii]), values[ii]);
+    EXPECT_EQ(function.jacobian(points[ii]), jacobians[ii]);
+  }
+}
+
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_jacobian_derived)
+{
+  RangeExpressionType expr(std::string(""));
+  for (size_t rr = 0; rr < r; ++rr)
+    expr[rr] = "exp(x[0])+sin(x[0])+" + Common::to_string(rr) + "*x[0]^2";
+  const FunctionType function_without_gradients("x", expr, 4);
+  EXPECT_THROW(function_without_gradients.jacobian(DomainType(0.)), Dune::NotImplemented);
+  const FunctionType function("x", expr, 4, FunctionType::static_id(), "interpreter", /*derive_gradients=*/true);
+  std::vector<DomainType> points;
+  for (auto point : {-1., -0.5, 0., 0.5, 1.})
+    points.emplace_back(point);
+  std::vector<DerivativeRangeReturnType> jacobians;
+  function.jacobian(points, jacobians);
+  ASSERT_EQ(points.size(), jacobians.size());
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    const double xx = points[ii][0];
+    RangeReturnType value;
+    DerivativeRangeReturnType jacobian;
+    function.evaluate_with_jacobian(points[ii], value, jacobian);
+    EXPECT_EQ(function.evaluate(points[ii]), value);
+    EXPECT_EQ(function.jacobian(points[ii]), jacobian);
+    EXPECT_EQ(jacobian, jacobians[ii]);
+    for (size_t rr = 0; rr < r; ++rr) {
+      const double expected_derivative = std::exp(xx) + std::cos(xx) + 2. * double(rr) * xx;
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_derivative, jacobian[rr][0])) << expected_derivative << " vs. "
+                                                                               << jacobian[rr][0];
+      for (size_t dd = 1; dd < d; ++dd)
+        EXPECT_EQ(0., jacobian[rr][dd]);
+    }
+  }
+}
+
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate_with_simplifications)
+{
+  // constants to be folded, trivial operations and common subexpressions within and across the components
+  RangeExpressionType expr(std::string(""));
+  for (size_t rr = 0; rr < r; ++rr)
+    expr[rr] = "2*pi*0.5*sin(0.5*pi*x[0])*sin(0.5*pi*x[0])+x[0]*1+0-(-x[0])+" + Common::to_string(rr) + "*x[0]^2";
+  const FunctionType function("x", expr, 2);
+  std::vector<DomainType> points;
+  for (auto point : {-1., -0.5, 0., 0.5, 1.})
+    points.emplace_back(point);
+  std::vector<RangeReturnType> values;
+  function.evaluate(points, values);
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    const double xx = points[ii][0];
+    const auto actual_value = function.evaluate(points[ii]);
+    for (size_t rr = 0; rr < r; ++rr) {
+      const double sine = std::sin(0.5 * M_PI * xx);
+      const double expected_value = M_PI * sine * sine + 2 * xx + double(rr) * xx * xx;
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_value, actual_value[rr])) << expected_value << " vs. "
+                                                                            << actual_value[rr];
+      EXPECT_EQ(actual_value[rr], values[ii][rr]);
+    }
+  }
+  // the simplification and the elimination of common subexpressions actually reduce the work
+  double variable_value = 0.;
+  RVar variable("x[0]", &variable_value);
+  PRVar variables[1] = {&variable};
+  const ROperation operation(expr[0].c_str(), 1, variables);
+  ROperation simplified_operation = operation.Simplify();
+  EXPECT_LT(simplified_operation.NInstructions(), operation.NInstructions());
+  char* simplified_expression = simplified_operation.Expr();
+  EXPECT_EQ(nullptr, std::strstr(simplified_expression, "0.5")) << simplified_expression;
+  delete[] simplified_expression;
+  const int num_instructions_before_cse = simplified_operation.NInstructions();
+  ROperation* operations[1] = {&simplified_operation};
+  double temporary_values[4];
+  PRVar temporary_variables[4];
+  ROperation* temporaries[4];
+  const int num_temporaries =
+      EliminateCommonSubexpressions(1, operations, 4, temporary_values, temporary_variables, temporaries);
+  ASSERT_EQ(1, num_temporaries); // sin(0.5*pi*x[0])
+  EXPECT_LT(simplified_operation.NInstructions() + temporaries[0]->NInstructions(), num_instructions_before_cse);
+  delete temporaries[0];
+  delete temporary_variables[0];
+}
+
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, jit_backend)
+{
+  RangeExpressionType expr(std::string(""));
+  DerivativeRangeExpressionType grad(std::string("0"));
+  for (size_t rr = 0; rr < r; ++rr) {
+    expr[rr] = "exp(x[0])+sin(x[0])+" + Common::to_string(rr) + "*x[0]^2";
+    grad[rr][0] = "exp(x[0])+cos(x[0])+" + Common::to_string(2 * rr) + "*x[0]";
+  }
+  const FunctionType interpreted_function("x", expr, grad, 4);
+  const FunctionType compiled_function("x", expr, grad, 4, "compiled_function", "jit");
+  EXPECT_EQ("interpreter", interpreted_function.backend());
+  // the jit backend silently falls back to the interpreter if no compiler is available, which is only fine without one
+  const char* compiler = std::getenv("DUNE_XT_FUNCTIONS_JIT_CXX");
+  const std::string compiler_command = std::string((compiler != nullptr && compiler[0] != '\0') ? compiler : "c++");
+  if (std::system((compiler_command + " --version > /dev/null 2>&1").c_str()) != 0) {
+    GTEST_SKIP() << "no compiler available for the jit backend (tried '" << compiler_command << "')";
+  }
+  EXPECT_EQ("jit", compiled_function.backend());
+  for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+    const DomainType xx(point);
+    const auto expected_value = interpreted_function.evaluate(xx);
+    const auto actual_value = compiled_function.evaluate(xx);
+    const auto expected_jacobian = interpreted_function.jacobian(xx);
+    const auto actual_jacobian = compiled_function.jacobian(xx);
+    for (size_t rr = 0; rr < r; ++rr) {
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_value[rr], actual_value[rr]));
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_jacobian[rr], actual_jacobian[rr]));
+    }
+  }
+}
+
+TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, vectorized_backend)
+{
+  RangeExpressionType expr(std::string(""));
+  for (size_t rr = 0; rr < r; ++rr)
+    expr[rr] = "exp(x[0])*sin(x[0])+cos(" + Common::to_string(rr)
+               + "*x[0])/(2+x[0])+log(2+x[0])-atan(x[0])*sqrt(2+x[0])";
+  const FunctionType interpreted_function("x", expr, 4);
+  const FunctionType vectorized_function("x", expr, 4, "vectorized_function", "vectorized");
+  EXPECT_EQ("vectorized", vectorized_function.backend());
+  // more points than fit into one block, the kernels are accurate up to a few ulp
+  std::vector<DomainType> points;
+  for (size_t ii = 0; ii < 150; ++ii)
+    points.emplace_back(-1. + 2. * double(ii) / 150.);
+  std::vector<RangeReturnType> expected_values;
+  interpreted_function.evaluate(points, expected_values);
+  std::vector<RangeReturnType> actual_values;
+  vectorized_function.evaluate(points, actual_values);
+  ASSERT_EQ(points.size(), actual_values.size());
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    EXPECT_EQ(interpreted_function.evaluate(points[ii]), vectorized_function.evaluate(points[ii]));
+    for (size_t rr = 0; rr < r; ++rr)
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_values[ii][rr], actual_values[ii][rr], 1e-13, 1e-13));
+  }
+}
+
 TEST_F(ExpressionFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable)
 {
   RangeExpressionType expr_1(std::string("x[0]*x[0]"));
@@ -2,6 +2,7 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
@@ -102,6 +103,33 @@ TEST_F(FlattopFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate)
   }
 }
 
+TEST_F(FlattopFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, global_evaluate_with_jacobian)
+{
+  const DomainType left(0);
+  const DomainType right(1);
+  const DomainType delta(0.1);
+  const double top_value = 20;
+  FunctionType function(left, right, delta, top_value);
+  const double hh = 1e-6;
+  for (auto point : {-0.5, -0.05, 0.05, 0.5, 0.95, 1.05, 1.5}) {
+    const DomainType xx(point);
+    RangeReturnType value;
+    DerivativeRangeReturnType jacobian;
+    function.evaluate_with_jacobian(xx, value, jacobian);
+    EXPECT_EQ(function.evaluate(xx), value);
+    EXPECT_EQ(function.jacobian(xx), jacobian);
+    for (size_t dd = 0; dd < d; ++dd) {
+      DomainType xx_plus = xx;
+      DomainType xx_minus = xx;
+      xx_plus[dd] += hh;
+      xx_minus[dd] -= hh;
+      const double expected_derivative = (function.evaluate(xx_plus)[0] - function.evaluate(xx_minus)[0]) / (2 * hh);
+      EXPECT_TRUE(Common::FloatCmp::eq(expected_derivative, jacobian[0][dd], 1e-6, 1e-6))
+          << expected_derivative << " vs. " << jacobian[0][dd];
+    }
+  }
+}
+
 TEST_F(FlattopFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, is_bindable)
 {
   const DomainType left(0);
@@ -11,10 +11,13 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <cmath>
+
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
 
+#include <dune/xt/functions/base/transformed.hh>
 #include <dune/xt/functions/generic/grid-function.hh>
 
 using namespace Dune::XT;
@@ -221,4 +224,44 @@ TEST_F(GenericFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_jacobian)
   }
 }
 
+TEST_F(GenericFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_with_bound_parameter)
+{
+  const auto leaf_view = grid_.leaf_view();
+
+  GenericType function(
+      [](const auto& param) { return int(param.get("power").at(0)); },
+      [](const auto&) {},
+      [](const auto& xx, const auto& param) { return RangeReturnType(std::pow(xx[0], param.get("power").at(0))); },
+      Common::ParameterType("power", 1),
+      "x^power");
+  // wrapped local functions pass the bound parameter on to theirs
+  const Functions::TransformedGridFunction<GenericType> transformed(function, [](const RangeType& value) {
+    RangeType ret(value);
+    ret *= 2.;
+    return ret;
+  });
+  auto local_f = function.local_function();
+  auto local_transformed = transformed.local_function();
+  for (auto power : {1., 2., 3.}) {
+    local_f->bind_parameter({"power", power});
+    local_transformed->bind_parameter({"power", power});
+    for (auto&& element : Dune::elements(leaf_view)) {
+      local_f->bind(element);
+      local_transformed->bind(element);
+      EXPECT_EQ(int(power), local_f->order());
+      EXPECT_EQ(int(power), local_transformed->order());
+      for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+        const auto local_x = quadrature_point.position();
+        const RangeReturnType expected_value(std::pow(local_x[0], power));
+        EXPECT_EQ(expected_value, local_f->evaluate(local_x));
+        RangeReturnType expected_transformed_value(expected_value);
+        expected_transformed_value *= 2.;
+        EXPECT_EQ(expected_transformed_value, local_transformed->evaluate(local_x));
+        // an explicitly given parameter takes precedence
+        EXPECT_EQ(RangeReturnType(local_x[0]), local_f->evaluate(local_x, {"power", 1.}));
+      }
+    }
+  }
+}
+
 {% endfor  %}
@@ -256,6 +256,57 @@ GTEST_TEST(SquareMatrixGridFunction, convertible_from_grid_function_lvalueptr)
       new GenericGridFunction<E, r, r>{0, [](auto&) {}, [](auto&, auto&) { return 1.; }, {}, "THE_NAME"});
 }
 
+GTEST_TEST(SquareMatrixGridFunction, from_double_is_scaled_unit_matrix)
+{
+  const auto grid = XT::Grid::make_cube_grid<G>(0., 1., 2);
+  GridFunction<E, r, r> func{2.};
+  auto local_func = func.local_function();
+  for (auto&& element : elements(grid.leaf_view())) {
+    local_func->bind(element);
+    const auto value = local_func->evaluate(ReferenceElements<double, d>::general(element.type()).position(0, 0));
+    for (size_t ii = 0; ii < r; ++ii)
+      for (size_t jj = 0; jj < r; ++jj)
+        EXPECT_EQ(ii == jj ? 2. : 0., value[ii][jj]);
+  }
+}
+
+GTEST_TEST(SquareMatrixGridFunction, from_scalar_function_is_scaled_unit_matrix)
+{
+  // the partial derivatives differ in each direction, to detect misplaced entries of the jacobian
+  const GenericFunction<d> scalar_function{1,
+                                           [](const auto& xx, const auto&) {
+                                             double ret = 1.;
+                                             for (size_t dd = 0; dd < d; ++dd)
+                                               ret += (dd + 1.) * xx[dd];
+                                             return ret;
+                                           },
+                                           "THE_NAME",
+                                           {},
+                                           [](const auto&, const auto&) {
+                                             XT::Common::FieldMatrix<double, 1, d> ret;
+                                             for (size_t dd = 0; dd < d; ++dd)
+                                               ret[0][dd] = dd + 1.;
+                                             return ret;
+                                           }};
+  const auto grid = XT::Grid::make_cube_grid<G>(0., 1., 2);
+  GridFunction<E, r, r> func{scalar_function};
+  EXPECT_EQ(std::string("THE_NAME"), func.name());
+  auto local_func = func.local_function();
+  for (auto&& element : elements(grid.leaf_view())) {
+    local_func->bind(element);
+    const auto xx = ReferenceElements<double, d>::general(element.type()).position(0, 0);
+    const auto expected_value = scalar_function.evaluate(element.geometry().global(xx))[0];
+    const auto value = local_func->evaluate(xx);
+    const auto jacobian = local_func->jacobian(xx);
+    for (size_t ii = 0; ii < r; ++ii)
+      for (size_t jj = 0; jj < r; ++jj) {
+        EXPECT_DOUBLE_EQ(ii == jj ? expected_value : 0., value[ii][jj]);
+        for (size_t dd = 0; dd < d; ++dd)
+          EXPECT_EQ(ii == jj ? dd + 1. : 0., jacobian[ii][jj][dd]);
+      }
+  }
+}
+
 
 // MatrixGridFunction
 
@@ -0,0 +1,121 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Has to come first, includes the config.h!
+
+#include <dune/xt/common/float_cmp.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/functions/generic/function.hh>
+#include <dune/xt/functions/inverse.hh>
+
+using namespace Dune;
+using namespace Dune::XT::Functions;
+
+using G = CUBEGRID_2D;
+static const constexpr size_t d = G::dimension;
+
+// from here on, the code should work for any d to allow for grid parametrization
+
+
+GTEST_TEST(InverseFunction, scalar_evaluate_with_jacobian)
+{
+  using FunctionType = GenericFunction<d>;
+  // positive on [0, 1]^d, the partial derivatives differ in each direction
+  FunctionType function(
+      2,
+      [](const auto& xx, const auto& /*param*/) {
+        typename FunctionType::RangeReturnType ret(1.);
+        for (size_t dd = 0; dd < d; ++dd)
+          ret[0] += (dd + 1.) * xx[dd] * xx[dd];
+        return ret;
+      },
+      "f",
+      {},
+      [](const auto& xx, const auto& /*param*/) {
+        typename FunctionType::DerivativeRangeReturnType ret;
+        for (size_t dd = 0; dd < d; ++dd)
+          ret[0][dd] = 2. * (dd + 1.) * xx[dd];
+        return ret;
+      });
+  const InverseFunction<FunctionType> inverse(function, 2);
+  const double hh = 1e-6;
+  for (auto point : {0., 0.25, 0.5, 1.}) {
+    typename FunctionType::DomainType xx(point);
+    xx[0] = 1. - point;
+    typename FunctionType::RangeReturnType value;
+    typename FunctionType::DerivativeRangeReturnType jacobian;
+    inverse.evaluate_with_jacobian(xx, value, jacobian);
+    EXPECT_EQ(inverse.evaluate(xx), value);
+    EXPECT_EQ(inverse.jacobian(xx), jacobian);
+    for (size_t dd = 0; dd < d; ++dd) {
+      auto xx_plus = xx;
+      auto xx_minus = xx;
+      xx_plus[dd] += hh;
+      xx_minus[dd] -= hh;
+      const double expected_derivative = (inverse.evaluate(xx_plus)[0] - inverse.evaluate(xx_minus)[0]) / (2 * hh);
+      EXPECT_TRUE(XT::Common::FloatCmp::eq(expected_derivative, jacobian[0][dd], 1e-6, 1e-6))
+          << expected_derivative << " vs. " << jacobian[0][dd];
+    }
+  }
+}
+
+GTEST_TEST(InverseFunction, matrix_evaluate_with_jacobian)
+{
+  using FunctionType = GenericFunction<d, 2, 2>;
+  // diagonally dominant on [0, 1]^d, so invertible, and each entry depends differently on x
+  FunctionType function(
+      2,
+      [](const auto& xx, const auto& /*param*/) {
+        typename FunctionType::RangeReturnType ret;
+        ret[0][0] = 3. + xx[0];
+        ret[0][1] = xx[0] * xx[d - 1];
+        ret[1][0] = 0.5 * xx[d - 1];
+        ret[1][1] = 4. - xx[0] + 2. * xx[d - 1];
+        return ret;
+      },
+      "A",
+      {},
+      [](const auto& xx, const auto& /*param*/) {
+        typename FunctionType::DerivativeRangeReturnType ret;
+        for (size_t ii = 0; ii < 2; ++ii)
+          for (size_t jj = 0; jj < 2; ++jj)
+            ret[ii][jj] = 0.;
+        ret[0][0][0] += 1.;
+        ret[0][1][0] += xx[d - 1];
+        ret[0][1][d - 1] += xx[0];
+        ret[1][0][d - 1] += 0.5;
+        ret[1][1][0] -= 1.;
+        ret[1][1][d - 1] += 2.;
+        return ret;
+      });
+  const InverseFunction<FunctionType> inverse(function, 2);
+  const double hh = 1e-6;
+  for (auto point : {0., 0.25, 0.5, 1.}) {
+    typename FunctionType::DomainType xx(point);
+    xx[0] = 1. - point;
+    typename FunctionType::RangeReturnType value;
+    typename FunctionType::DerivativeRangeReturnType jacobian;
+    inverse.evaluate_with_jacobian(xx, value, jacobian);
+    EXPECT_EQ(inverse.evaluate(xx), value);
+    EXPECT_EQ(inverse.jacobian(xx), jacobian);
+    for (size_t dd = 0; dd < d; ++dd) {
+      auto xx_plus = xx;
+      auto xx_minus = xx;
+      xx_plus[dd] += hh;
+      xx_minus[dd] -= hh;
+      const auto value_plus = inverse.evaluate(xx_plus);
+      const auto value_minus = inverse.evaluate(xx_minus);
+      for (size_t ii = 0; ii < 2; ++ii)
+        for (size_t jj = 0; jj < 2; ++jj) {
+          const double expected_derivative = (value_plus[ii][jj] - value_minus[ii][jj]) / (2 * hh);
+          EXPECT_TRUE(XT::Common::FloatCmp::eq(expected_derivative, jacobian[ii][jj][dd], 1e-6, 1e-6))
+              << expected_derivative << " vs. " << jacobian[ii][jj][dd];
+        }
+    }
+  }
+}
@@ -0,0 +1,153 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Has to come first, includes the config.h!
+
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/functions/base/reinterpret.hh>
+#include <dune/xt/functions/checkerboard.hh>
+#include <dune/xt/functions/generic/function.hh>
+#include <dune/xt/functions/grid-function.hh>
+
+using namespace Dune;
+using namespace Dune::XT::Functions;
+
+using G = CUBEGRID_2D;
+using E = XT::Grid::extract_entity_t<G>;
+static const constexpr size_t d = G::dimension;
+
+// from here on, the code should work for any E and d to allow for grid parametrization
+
+
+/**
+ * The points at which the reinterpreted functions are compared on target_element: the quadrature points (which lie in
+ * the interior) and the corners, many of which lie on boundaries of source elements.
+ */
+std::vector<FieldVector<double, d>> points_to_compare(const E& target_element)
+{
+  std::vector<FieldVector<double, d>> points;
+  for (const auto& quadrature_point : QuadratureRules<double, d>::rule(target_element.type(), 2))
+    points.emplace_back(quadrature_point.position());
+  const auto& reference_element = ReferenceElements<double, d>::general(target_element.type());
+  for (int ii = 0; ii < reference_element.size(d); ++ii)
+    points.emplace_back(reference_element.position(ii, d));
+  return points;
+}
+
+
+struct ReinterpretLocalizableFunctionTest : public ::testing::Test
+{
+  ReinterpretLocalizableFunctionTest()
+    : source_grid_(XT::Grid::make_cube_grid<G>(0., 1., 4))
+    , target_grid_(XT::Grid::make_cube_grid<G>(0., 1., 6)) // the corners at 0.5 lie on the source element boundaries
+    , source_grid_view_(source_grid_.leaf_view())
+    , target_grid_view_(target_grid_.leaf_view())
+  {}
+
+  using SourceGridViewType = decltype(std::declval<XT::Grid::GridProvider<G>>().leaf_view());
+  using ReinterpretedType = ReinterpretLocalizableFunction<SourceGridViewType, E>;
+
+  template <bool interior_points_only>
+  void compare(const GridFunctionInterface<E>& source) const
+  {
+    ReinterpretedType searching_function(source, source_grid_view_);
+    ReinterpretedType precomputed_function(source, source_grid_view_);
+    precomputed_function.precompute_source_elements(target_grid_view_);
+    auto searching_local_function = searching_function.local_function();
+    auto precomputed_local_function = precomputed_function.local_function();
+    for (auto&& target_element : elements(target_grid_view_)) {
+      searching_local_function->bind(target_element);
+      precomputed_local_function->bind(target_element);
+      EXPECT_EQ(searching_local_function->order(), precomputed_local_function->order());
+      const auto points = points_to_compare(target_element);
+      const size_t num_points =
+          interior_points_only ? QuadratureRules<double, d>::rule(target_element.type(), 2).size() : points.size();
+      for (size_t pp = 0; pp < num_points; ++pp) {
+        const auto expected_value = searching_local_function->evaluate(points[pp]);
+        const auto actual_value = precomputed_local_function->evaluate(points[pp]);
+        EXPECT_DOUBLE_EQ(expected_value[0], actual_value[0])
+            << "target element center: " << target_element.geometry().center() << "\n   point: " << points[pp];
+      }
+    }
+  } // ... compare(...)
+
+  XT::Grid::GridProvider<G> source_grid_;
+  XT::Grid::GridProvider<G> target_grid_;
+  const SourceGridViewType source_grid_view_;
+  const SourceGridViewType target_grid_view_;
+}; // struct ReinterpretLocalizableFunctionTest
+
+
+TEST_F(ReinterpretLocalizableFunctionTest, precomputed_source_elements_of_continuous_function)
+{
+  // continuous, so the values on source element boundaries do not depend on the chosen source element
+  const GenericFunction<d> function(1, [](const auto& xx, const auto& /*param*/) { return xx[0] + 2 * xx[1]; });
+  const GridFunction<E> source(function);
+  compare<false>(source);
+}
+
+TEST_F(ReinterpretLocalizableFunctionTest, precomputed_source_elements_of_discontinuous_function)
+{
+  std::vector<FieldVector<double, 1>> values;
+  for (size_t ii = 0; ii < 16; ++ii) // 4 x 4 subdomains
+    values.emplace_back(ii + 1.);
+  const CheckerboardFunction<E> source(
+      FieldVector<double, d>(0.), FieldVector<double, d>(1.), FieldVector<size_t, d>(4), values);
+  // the values on source element boundaries would depend on the chosen source element
+  compare<true>(source);
+}
+
+TEST_F(ReinterpretLocalizableFunctionTest, precomputed_source_elements_outside_of_source_domain)
+{
+  const GenericFunction<d> function(1, [](const auto& xx, const auto& /*param*/) { return xx[0] + 2 * xx[1]; });
+  const GridFunction<E> source(function);
+  const auto larger_grid = XT::Grid::make_cube_grid<G>(-0.5, 1.5, 4);
+  const auto larger_grid_view = larger_grid.leaf_view();
+  ReinterpretedType precomputed_function(source, source_grid_view_);
+  precomputed_function.precompute_source_elements(larger_grid_view);
+  auto precomputed_local_function = precomputed_function.local_function();
+  for (auto&& target_element : elements(larger_grid_view)) {
+    precomputed_local_function->bind(target_element);
+    const auto center = target_element.geometry().center();
+    const auto value = precomputed_local_function->evaluate(target_element.geometry().local(center));
+    if (center[0] < 0 || center[0] > 1 || center[1] < 0 || center[1] > 1)
+      EXPECT_EQ(0., value[0]);
+    else
+      EXPECT_DOUBLE_EQ(center[0] + 2 * center[1], value[0]);
+  }
+}
+
+TEST_F(ReinterpretLocalizableFunctionTest, precomputed_source_elements_are_replaced_after_refinement)
+{
+  const GenericFunction<d> function(1, [](const auto& xx, const auto& /*param*/) { return xx[0] + 2 * xx[1]; });
+  const GridFunction<E> source(function);
+  ReinterpretedType precomputed_function(source, source_grid_view_);
+  precomputed_function.precompute_source_elements(target_grid_view_);
+  source_grid_.grid().globalRefine(1);
+  target_grid_.grid().globalRefine(1);
+  precomputed_function.precompute_source_elements(target_grid_view_);
+  ReinterpretedType searching_function(source, source_grid_view_);
+  auto searching_local_function = searching_function.local_function();
+  auto precomputed_local_function = precomputed_function.local_function();
+  for (auto&& target_element : elements(target_grid_view_)) {
+    searching_local_function->bind(target_element);
+    precomputed_local_function->bind(target_element);
+    for (const auto& point : points_to_compare(target_element)) {
+      const auto expected_value = searching_local_function->evaluate(point);
+      const auto actual_value = precomputed_local_function->evaluate(point);
+      EXPECT_DOUBLE_EQ(expected_value[0], actual_value[0])
+          << "target element center: " << target_element.geometry().center() << "\n   point: " << point;
+    }
+  }
+}
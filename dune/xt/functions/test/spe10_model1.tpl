@@ -2,6 +2,13 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
 #include <dune/xt/data/paths.hh>
 
 #include <dune/xt/grid/grids.hh>
@@ -12,6 +19,32 @@
 
 using namespace Dune::XT;
 
+
+// a new file in the temporary directory, which is removed again on destruction
+struct TemporaryFile
+{
+  TemporaryFile(const std::string& prefix)
+  {
+    const char* tmp_dir = std::getenv("TMPDIR");
+    std::string pattern = std::string((tmp_dir != nullptr && tmp_dir[0] != '\0') ? tmp_dir : "/tmp") + "/" + prefix
+                          + "XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    const int fd = mkstemp(buffer.data());
+    if (fd < 0)
+      DUNE_THROW(Dune::IOError, "could not create a temporary file from '" << pattern << "'!");
+    close(fd);
+    filename = buffer.data();
+  }
+
+  ~TemporaryFile()
+  {
+    std::remove(filename.c_str());
+  }
+
+  std::string filename;
+}; // struct TemporaryFile
+
 {% for GRIDNAME, GRID, r, rC in config['types'] %}
 
 
@@ -152,4 +185,32 @@ TEST_F(Spe10Model1Function_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_jacobi
   }
 }
 
+TEST_F(Spe10Model1Function_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, local_evaluate_from_binary_data_file)
+{
+  const auto leaf_view = grid_.leaf_view();
+  auto filename = Dune::XT::Data::spe10_model1_filename();
+  const TemporaryFile binary_file("spe10_model1_{{GRIDNAME}}_to_{{r}}_times_{{rC}}.bin.");
+  const std::string& binary_filename = binary_file.filename;
+  Functions::Spe10::convert_to_binary(filename, binary_filename);
+  EXPECT_TRUE(Functions::Spe10::DataFile(binary_filename).is_binary());
+  FunctionType ascii_function(
+      filename,
+      {0, 0},
+      {Dune::XT::Functions::Spe10::internal::model_1_length_x, Dune::XT::Functions::Spe10::internal::model_1_length_z});
+  FunctionType binary_function(
+      binary_filename,
+      {0, 0},
+      {Dune::XT::Functions::Spe10::internal::model_1_length_x, Dune::XT::Functions::Spe10::internal::model_1_length_z});
+  auto ascii_local_f = ascii_function.local_function();
+  auto binary_local_f = binary_function.local_function();
+  for (auto&& element : Dune::elements(leaf_view)) {
+    ascii_local_f->bind(element);
+    binary_local_f->bind(element);
+    for (const auto& quadrature_point : Dune::QuadratureRules<double, d>::rule(element.type(), 3)) {
+      const auto local_x = quadrature_point.position();
+      EXPECT_EQ(ascii_local_f->evaluate(local_x), binary_local_f->evaluate(local_x));
+    }
+  }
+}
+
 {% endfor  %}
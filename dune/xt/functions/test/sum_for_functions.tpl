@@ -2,12 +2,15 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/grid/grids.hh>
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/xt/grid/gridprovider/cube.hh>
 
 #include <dune/xt/functions/base/combined-functions.hh>
+#include <dune/xt/functions/base/function-expressions.hh>
 #include <dune/xt/functions/constant.hh>
+#include <dune/xt/functions/generic/function.hh>
 
 /**
  * todo: Tests for combined_functions
@@ -30,16 +33,48 @@ struct SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}} : public ::testing::T
 
   using SumFunctionType = Dune::XT::Functions::SumFunction<ConstantFunctionType, ConstantFunctionType>;
 
+  using ScalarFunctionType = Dune::XT::Functions::GenericFunction<d>;
+  using ScaledFunctionType = Dune::XT::Functions::ProductFunction<ScalarFunctionType, ConstantFunctionType>;
+
   using RangeReturnType = typename ConstantFunctionType::RangeReturnType;
   using DomainType = typename ConstantFunctionType::DomainType;
   using DerivativeRangeReturnType = typename ConstantFunctionType::DerivativeRangeReturnType;
 
   SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}()
     : grid_(Dune::XT::Grid::make_cube_grid<GridType>(-1., 1., 4))
+    // the partial derivatives of s_ differ in each direction
+    , s_(1,
+         [](const auto& xx, const auto& /*param*/) {
+           typename ScalarFunctionType::RangeReturnType ret(1.);
+           for (size_t dd = 0; dd < d; ++dd)
+             ret[0] += (dd + 1.) * xx[dd];
+           return ret;
+         },
+         "s",
+         {},
+         [](const auto& /*xx*/, const auto& /*param*/) {
+           typename ScalarFunctionType::DerivativeRangeReturnType ret;
+           for (size_t dd = 0; dd < d; ++dd)
+             ret[0][dd] = dd + 1.;
+           return ret;
+         })
+    , t_(2,
+         [](const auto& xx, const auto& /*param*/) {
+           return typename ScalarFunctionType::RangeReturnType(xx[0] * xx[0]);
+         },
+         "t",
+         {},
+         [](const auto& xx, const auto& /*param*/) {
+           typename ScalarFunctionType::DerivativeRangeReturnType ret(0.);
+           ret[0][0] = 2. * xx[0];
+           return ret;
+         })
   {
   }
 
   const Dune::XT::Grid::GridProvider<GridType> grid_;
+  const ScalarFunctionType s_;
+  const ScalarFunctionType t_;
 };
 
 
@@ -76,4 +111,106 @@ TEST_F(SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, operator_works)
 }
 
 
+TEST_F(SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, expression_works)
+{
+  ConstantFunctionType f(3.);
+  ConstantFunctionType g(2.);
+  ConstantFunctionType h(8.);
+
+  SumFunctionType manual_sum(f, g);
+
+  const auto sum = Dune::XT::Functions::expression(f) + g;
+  const auto minus = h - Dune::XT::Functions::expression(f);
+  const auto nested = sum + h - Dune::XT::Functions::expression(h);
+
+  for (auto point : {-100., -10., 0., 10., 100.}) {
+    const DomainType xx(point);
+    const auto manual_value = manual_sum.evaluate(xx);
+    EXPECT_EQ(sum.evaluate(xx), manual_value);
+    EXPECT_EQ(minus.evaluate(xx), manual_value);
+    EXPECT_EQ(nested.evaluate(xx), manual_value);
+    EXPECT_EQ(nested.jacobian(xx), manual_sum.jacobian(xx));
+  }
+}
+
+
+TEST_F(SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, expression_of_nonconstant_functions_works)
+{
+  using VirtualSumType = Dune::XT::Functions::SumFunction<ScaledFunctionType, ScaledFunctionType>;
+  ConstantFunctionType f(3.);
+  ConstantFunctionType g(2.);
+
+  const ScaledFunctionType virtual_sf(s_, f);
+  const ScaledFunctionType virtual_tg(t_, g);
+  const VirtualSumType virtual_sum(virtual_sf, virtual_tg);
+  const Dune::XT::Functions::DifferenceFunction<ScaledFunctionType, ScaledFunctionType> virtual_difference(virtual_sf,
+                                                                                                          virtual_tg);
+  const Dune::XT::Functions::ProductFunction<ScalarFunctionType, VirtualSumType> virtual_product(t_, virtual_sum);
+
+  const auto sf = Dune::XT::Functions::expression(s_) * f;
+  const auto tg = Dune::XT::Functions::expression(t_) * g;
+  const auto sum = sf + tg;
+  const auto difference = sf - tg;
+  const auto product = Dune::XT::Functions::expression(t_) * sum;
+
+  const auto check = [](const auto& expected, const auto& actual, const DomainType& xx) {
+    EXPECT_EQ(expected.evaluate(xx), actual.evaluate(xx)) << actual.name() << ", xx = " << xx;
+    EXPECT_EQ(expected.jacobian(xx), actual.jacobian(xx)) << actual.name() << ", xx = " << xx;
+    RangeReturnType expected_value, actual_value;
+    DerivativeRangeReturnType expected_jacobian, actual_jacobian;
+    expected.evaluate_with_jacobian(xx, expected_value, expected_jacobian);
+    actual.evaluate_with_jacobian(xx, actual_value, actual_jacobian);
+    EXPECT_EQ(expected_value, actual_value) << actual.name() << ", xx = " << xx;
+    EXPECT_EQ(expected_jacobian, actual_jacobian) << actual.name() << ", xx = " << xx;
+  };
+  for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+    DomainType xx(point);
+    xx[0] = 0.25 - point;
+    check(virtual_sum, sum, xx);
+    check(virtual_difference, difference, xx);
+    check(virtual_product, product, xx);
+  }
+}
+
+
+TEST_F(SumFunction_from_{{GRIDNAME}}_to_{{r}}_times_{{rC}}, product_evaluate_with_jacobian)
+{
+  // both factors are non-constant, so both terms of the product rule contribute
+  ConstantFunctionType g(2.);
+  const ScaledFunctionType tg(t_, g);
+  const Dune::XT::Functions::ProductFunction<ScalarFunctionType, ScaledFunctionType> product(s_, tg);
+  const double hh = 1e-6;
+  for (auto point : {-1., -0.5, 0., 0.5, 1.}) {
+    DomainType xx(point);
+    xx[0] = 0.25 - point;
+    RangeReturnType value;
+    DerivativeRangeReturnType jacobian;
+    product.evaluate_with_jacobian(xx, value, jacobian);
+    EXPECT_TRUE(Common::FloatCmp::eq(product.evaluate(xx), value)) << product.evaluate(xx) << " vs. " << value;
+    EXPECT_EQ(product.jacobian(xx), jacobian);
+    for (size_t dd = 0; dd < d; ++dd) {
+      DomainType xx_plus = xx;
+      DomainType xx_minus = xx;
+      xx_plus[dd] += hh;
+      xx_minus[dd] -= hh;
+      const auto value_plus = product.evaluate(xx_plus);
+      const auto value_minus = product.evaluate(xx_minus);
+      for (size_t ii = 0; ii < r; ++ii) {
+{% if rC == 1 %}
+        const double expected_derivative = (value_plus[ii] - value_minus[ii]) / (2 * hh);
+        EXPECT_TRUE(Common::FloatCmp::eq(expected_derivative, jacobian[ii][dd], 1e-6, 1e-6))
+            << expected_derivative << " vs. " << jacobian[ii][dd];
+{% else %}
+        for (size_t jj = 0; jj < rC; ++jj) {
+          const double expected_derivative = (value_plus[ii][jj] - value_minus[ii][jj]) / (2 * hh);
+          EXPECT_TRUE(Common::FloatCmp::eq(expected_derivative, jacobian[ii][jj][dd], 1e-6, 1e-6))
+              << expected_derivative << " vs. " << jacobian[ii][jj][dd];
+        }
+{% endif %}
+      }
+    }
+  }
+}
+
+
 {% endfor  %}
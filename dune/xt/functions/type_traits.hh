@@ -204,6 +204,9 @@ class FunctionInterface;
 template <class E, size_t r, size_t rC, class R>
 class GridFunctionInterface;
 
+template <class GridFunctionImp, class E, size_t r, size_t rC, class R>
+class StaticGridFunctionInterface;
+
 
 namespace internal {
 
@@ -244,6 +247,15 @@ struct is_grid_function_helper
 }; // struct is_grid_function_helper
 
 
+template <class Tt>
+struct is_static_grid_function_helper
+{
+  DXTC_has_typedef_initialize_once(StaticLocalFunctionType);
+  static const bool is_candidate =
+      is_grid_function_helper<Tt>::is_candidate && DXTC_has_typedef(StaticLocalFunctionType)<Tt>::value;
+}; // struct is_static_grid_function_helper
+
+
 } // namespace internal
 
 
@@ -284,6 +296,22 @@ struct is_grid_function<T, true> : std::is_base_of<GridFunctionInterface<typenam
 {};
 
 
+/**
+ * \brief Detects grid functions providing the static interface, see StaticGridFunctionInterface.
+ */
+template <class T, bool is_candidate = internal::is_static_grid_function_helper<T>::is_candidate>
+struct is_static_grid_function;
+
+template <class T>
+struct is_static_grid_function<T, false> : public std::false_type
+{};
+
+template <class T>
+struct is_static_grid_function<T, true>
+  : std::is_base_of<StaticGridFunctionInterface<T, typename T::E, T::r, T::rC, typename T::R>, T>
+{};
+
+
 enum class CombinationType
 {
   difference,
@@ -13,8 +13,12 @@
 #ifndef PYTHON_DUNE_XT_FUNCTIONS_CHECKERBOARD_HH
 #define PYTHON_DUNE_XT_FUNCTIONS_CHECKERBOARD_HH
 
+#include <memory>
+
 #include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/numpy.h>
 
+#include <dune/xt/common/numeric_cast.hh>
 #include <dune/xt/common/string.hh>
 
 #include <dune/xt/grid/type_traits.hh>
@@ -28,6 +32,85 @@
 namespace Dune {
 namespace XT {
 namespace Functions {
+namespace internal {
+
+
+template <class K, int ROWS, int COLS>
+K get_entry(const FieldMatrix<K, ROWS, COLS>& value, const size_t rr, const size_t cc)
+{
+  return value[rr][cc];
+}
+
+template <class K, int SIZE>
+K get_entry(const FieldVector<K, SIZE>& value, const size_t rr, const size_t /*cc*/)
+{
+  return value[rr];
+}
+
+
+/**
+ * \brief Creates the values of a checkerboard function from a numpy array of shape (num_subdomains, r, rC) (or any
+ *        other shape with a multiple of r * rC entries, read row-wise), see CheckerboardFunction::ContiguousValues.
+ *
+ *        If copy is false and values is a contiguous array of R, its memory is used directly (and values is kept
+ *        alive). Otherwise the entries are copied at once.
+ */
+template <class C>
+std::shared_ptr<const typename C::ValuesInterface> make_checkerboard_values(pybind11::array values, const bool copy)
+{
+  namespace py = pybind11;
+  using R = typename C::RangeFieldType;
+  using ValuesType = typename C::ContiguousValues;
+  auto array = py::array_t<R, py::array::c_style | py::array::forcecast>::ensure(values);
+  if (!array)
+    throw py::error_already_set();
+  const R* data = array.data();
+  const size_t size = Common::numeric_cast<size_t>(array.size());
+  if (copy)
+    return std::make_shared<const ValuesType>(std::vector<R>(data, data + size));
+  // the array has to be released with the GIL held
+  std::shared_ptr<const void> storage(new py::object(array), [](py::object* obj) {
+    py::gil_scoped_acquire gil;
+    delete obj;
+  });
+  return std::make_shared<const ValuesType>(data, size, std::move(storage));
+} // ... make_checkerboard_values(...)
+
+
+/**
+ * \brief The values of a checkerboard function as a numpy array of shape (num_subdomains, r, rC).
+ *
+ *        If the values are stored contiguously (see CheckerboardFunction::ContiguousValues), the array is a read-only
+ *        view of their memory (keeping self alive), otherwise the values are copied.
+ */
+template <class C>
+pybind11::array checkerboard_values_as_array(const C& function, pybind11::handle self)
+{
+  namespace py = pybind11;
+  using R = typename C::RangeFieldType;
+  static const constexpr size_t r = C::r;
+  static const constexpr size_t rC = C::rC;
+  const auto& values = function.values();
+  const std::vector<ssize_t> shape{ssize_t(values.size()), ssize_t(r), ssize_t(rC)};
+  const auto* contiguous_values = dynamic_cast<const typename C::ContiguousValues*>(&values);
+  if (contiguous_values != nullptr) {
+    py::array_t<R> view(shape, contiguous_values->data(), self);
+    view.attr("setflags")(py::arg("write") = false);
+    return std::move(view);
+  }
+  py::array_t<R> ret(shape);
+  auto entries = ret.template mutable_unchecked<3>();
+  for (size_t ss = 0; ss < values.size(); ++ss) {
+    const auto value = values.get(ss);
+    for (size_t rr = 0; rr < r; ++rr)
+      for (size_t cc = 0; cc < rC; ++cc)
+        entries(ss, rr, cc) = get_entry(value, rr, cc);
+  }
+  return std::move(ret);
+} // ... checkerboard_values_as_array(...)
+
+
+} // namespace internal
 
 
 /**
@@ -71,8 +154,29 @@ bind_CheckerboardFunction(pybind11::module& m, const std::string& grid_id)
         "num_elements"_a,
         "values"_a,
         "name"_a = C::static_id());
+  c.def(py::init([](const Common::FieldVector<D, d>& lower_left,
+                    const Common::FieldVector<D, d>& upper_right,
+                    const Common::FieldVector<size_t, d>& num_elements,
+                    py::array values,
+                    const bool copy,
+                    const std::string& name) {
+          return std::make_unique<C>(
+              lower_left, upper_right, num_elements, internal::make_checkerboard_values<C>(values, copy), name);
+        }),
+        "lower_left"_a,
+        "upper_right"_a,
+        "num_elements"_a,
+        "values"_a,
+        "copy"_a = false,
+        "name"_a = C::static_id(),
+        "Creates the function from a numpy array of shape (num_subdomains, r, rC), which is used without copying it "
+        "(if it is a contiguous array of doubles and copy is False).");
 
   c.def_property_readonly("static_id", [](const C& /*self*/) { return C::static_id(); });
+  c.def_property_readonly(
+      "values",
+      [](py::object self) { return internal::checkerboard_values_as_array(self.cast<const C&>(), self); },
+      "The values of all subdomains as an array of shape (num_subdomains, r, rC), a read-only view if possible.");
 
   const std::string make_name = "make_checkerboard_function_" + Common::to_string(r) + "x" + Common::to_string(rC);
   m.def(std::string(make_name).c_str(),
@@ -18,10 +18,13 @@
 
 #include <python/dune/xt/common/bindings.hh>
 #include <python/dune/xt/grid/grids.bindings.hh>
+#include <dune/xt/common/numeric_cast.hh>
 #include <dune/xt/grid/gridprovider/provider.hh>
 
 #include <dune/xt/functions/interfaces/function.hh>
 
+#include "numpy.hh"
+
 namespace Dune {
 namespace XT {
 namespace Functions {
@@ -178,6 +181,30 @@ pybind11::class_<FunctionInterface<d, r, rC, double>> bind_FunctionInterface(pyb
   c.def_property_readonly("static_id", [](const C& /*self*/) { return C::static_id(); });
   c.def_property_readonly("name", [](const C& self) { return self.name(); });
 
+  c.def("evaluate",
+        [](const C& self, const bindings::internal::NumpyArray& points, const ssize_t num_threads) {
+          return bindings::internal::evaluate_points<d>(
+              points, {ssize_t(r), ssize_t(rC)}, Common::numeric_cast<size_t>(num_threads), [&](const auto& xx) {
+                return self.evaluate(xx);
+              });
+        },
+        "points"_a,
+        "num_threads"_a = Common::threadManager().max_threads(),
+        "Evaluates the function in all points (an array of shape (num_points, d)), returns an array of shape "
+        "(num_points, r, rC). The evaluations are carried out in C++, without the GIL and in parallel for many points, "
+        "so the function has to be thread safe.");
+  c.def("jacobian",
+        [](const C& self, const bindings::internal::NumpyArray& points, const ssize_t num_threads) {
+          return bindings::internal::evaluate_points<d>(points,
+                                                        {ssize_t(r), ssize_t(rC), ssize_t(d)},
+                                                        Common::numeric_cast<size_t>(num_threads),
+                                                        [&](const auto& xx) { return self.jacobian(xx); });
+        },
+        "points"_a,
+        "num_threads"_a = Common::threadManager().max_threads(),
+        "Computes the jacobian of the function in all points (an array of shape (num_points, d)), returns an array of "
+        "shape (num_points, r, rC, d), see evaluate.");
+
   //  c.def("visualize",
   //        [](const C& self,
   //           const Grid::GridProvider<G>& grid_provider,
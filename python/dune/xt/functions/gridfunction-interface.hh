@@ -23,6 +23,8 @@
 #include <dune/xt/functions/interfaces/grid-function.hh>
 #include <dune/xt/functions/interfaces/function.hh>
 
+#include "numpy.hh"
+
 namespace Dune {
 namespace XT {
 namespace Functions {
@@ -358,6 +360,37 @@ bind_GridFunctionInterface(pybind11::module& m, const std::string& grid_id)
         "level"_a = -1,
         "path"_a,
         "subsampling"_a = true);
+  c.def("sample_at_quadrature_points",
+        [](const C& self,
+           const Grid::GridProvider<G>& grid_provider,
+           const std::string& layer,
+           const ssize_t lvl,
+           const ssize_t order,
+           const ssize_t num_threads) {
+          const auto level = XT::Common::numeric_cast<int>(lvl);
+          const auto threads = XT::Common::numeric_cast<size_t>(num_threads);
+          if (layer == "leaf")
+            return internal::sample_at_quadrature_points(self, grid_provider.leaf_view(), int(order), threads);
+          else if (layer == "level")
+            return internal::sample_at_quadrature_points(
+                self,
+                grid_provider.template layer<XT::Grid::Layers::level, XT::Grid::Backends::view>(level),
+                int(order),
+                threads);
+          else
+            DUNE_THROW(XT::Common::Exceptions::wrong_input_given,
+                       "Given layer has to be one of ('leaf', 'level'), is '" << layer << "'!");
+        },
+        "grid_provider"_a,
+        "layer"_a = "leaf",
+        "level"_a = -1,
+        "order"_a = -1,
+        "num_threads"_a = Common::threadManager().max_threads(),
+        "Evaluates the function in all quadrature points (of the given order, or of the order of the local function if "
+        "negative) of all elements, returns a tuple (points, weights, values) of arrays of shapes (num_points, d), "
+        "(num_points,) and (num_points, r, rC). The points are given in global coordinates and the weights contain the "
+        "integration elements, so that sum(weights * values) approximates the integral. The evaluations are carried "
+        "out in C++, without the GIL and in parallel for many elements.");
 
   // internal::Divergence<G>::addbind(m, c);
 
@@ -0,0 +1,235 @@
+// This file is part of the dune-xt-functions project:
+//   https://github.com/dune-community/dune-xt-functions
+// Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef PYTHON_DUNE_XT_FUNCTIONS_NUMPY_HH
+#define PYTHON_DUNE_XT_FUNCTIONS_NUMPY_HH
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/numpy.h>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+
+namespace Dune {
+namespace XT {
+namespace Functions {
+namespace bindings {
+namespace internal {
+
+
+/// Contiguous (C order) array of doubles, numpy arrays of other types or layouts are converted (i.e. copied).
+using NumpyArray = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>;
+
+
+/// Minimal number of points (or elements) handled by each thread, see parallel_for.
+static const constexpr size_t min_points_per_thread = 1024;
+
+
+/**
+ * \brief Calls work(begin, end) for consecutive ranges covering 0, ..., size - 1, using up to num_threads threads (so
+ *        that each one handles at least min_points_per_thread items).
+ *
+ *        Exceptions thrown by work are rethrown in the calling thread. Does not touch any python object and may (and
+ *        should) thus be called with the GIL released.
+ */
+template <class WorkType>
+void parallel_for(const size_t size, const size_t num_threads, const WorkType& work)
+{
+  const size_t threads_to_use =
+      std::max(size_t(1), std::min(std::max(num_threads, size_t(1)), size / min_points_per_thread));
+  if (threads_to_use == 1) {
+    work(size_t(0), size);
+    return;
+  }
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> exceptions(threads_to_use);
+  for (size_t tt = 0; tt < threads_to_use; ++tt) {
+    const size_t begin = (tt * size) / threads_to_use;
+    const size_t end = ((tt + 1) * size) / threads_to_use;
+    const auto run = [&, tt, begin, end]() {
+      try {
+        work(begin, end);
+      } catch (...) {
+        exceptions[tt] = std::current_exception();
+      }
+    };
+    if (tt + 1 < threads_to_use)
+      threads.emplace_back(run);
+    else
+      run();
+  }
+  for (auto& thread : threads)
+    thread.join();
+  for (const auto& exception : exceptions)
+    if (exception)
+      std::rethrow_exception(exception);
+} // ... parallel_for(...)
+
+
+/**
+ * \brief Copies all entries of a value (scalar, vector, matrix or vector of matrices, in this order) to dst and
+ *        advances dst accordingly.
+ * \{
+ */
+inline void copy_entries(const double& value, double*& dst)
+{
+  *dst++ = value;
+}
+
+template <class K, int SIZE>
+void copy_entries(const FieldVector<K, SIZE>& vector, double*& dst);
+
+template <class K, int ROWS, int COLS>
+void copy_entries(const FieldMatrix<K, ROWS, COLS>& matrix, double*& dst)
+{
+  for (int ii = 0; ii < ROWS; ++ii)
+    copy_entries(matrix[ii], dst);
+}
+
+template <class K, int SIZE>
+void copy_entries(const FieldVector<K, SIZE>& vector, double*& dst)
+{
+  for (int ii = 0; ii < SIZE; ++ii)
+    copy_entries(vector[ii], dst);
+}
+/// \}
+
+
+/**
+ * \brief Checks that points is of shape (num_points, d), see evaluate_points.
+ * \return num_points
+ */
+template <size_t d>
+size_t check_points(const NumpyArray& points)
+{
+  DUNE_THROW_IF(points.ndim() != 2 || points.shape(1) != ssize_t(d),
+                Common::Exceptions::shapes_do_not_match,
+                "points has to be of shape (num_points, " << d << "), has " << points.ndim() << " dimensions!");
+  return size_t(points.shape(0));
+}
+
+
+/**
+ * \brief Writes evaluate(x) (which has to return value_size entries, see copy_entries) to the pp-th row of a new numpy
+ *        array of the given shape, for the pp-th row x of points.
+ *
+ *        The evaluations are carried out without the GIL, using up to num_threads threads (see parallel_for), so
+ *        evaluate has to be reentrant.
+ */
+template <size_t d, class EvaluateType>
+pybind11::array_t<double> evaluate_points(const NumpyArray& points,
+                                          std::vector<ssize_t> value_shape,
+                                          const size_t num_threads,
+                                          const EvaluateType& evaluate)
+{
+  const size_t num_points = check_points<d>(points);
+  size_t value_size = 1;
+  for (const auto& extent : value_shape)
+    value_size *= size_t(extent);
+  value_shape.insert(value_shape.begin(), ssize_t(num_points));
+  pybind11::array_t<double> values(value_shape);
+  const double* points_data = points.data();
+  double* values_data = values.mutable_data();
+  {
+    pybind11::gil_scoped_release release;
+    parallel_for(num_points, num_threads, [&](const size_t begin, const size_t end) {
+      FieldVector<double, d> xx;
+      for (size_t pp = begin; pp < end; ++pp) {
+        for (size_t dd = 0; dd < d; ++dd)
+          xx[dd] = points_data[pp * d + dd];
+        double* dst = values_data + pp * value_size;
+        copy_entries(evaluate(xx), dst);
+      }
+    });
+  }
+  return values;
+} // ... evaluate_points(...)
+
+
+/**
+ * \brief Evaluates grid_function in all quadrature points of all elements of grid_view.
+ *
+ *        The quadrature of each element is of the given order, or of the order of the local function if order is
+ *        negative. The evaluations are carried out without the GIL, using up to num_threads threads (each with its own
+ *        local function, see parallel_for).
+ *
+ * \return (points, weights, values), arrays of shapes (num_points, d), (num_points,) and (num_points, r, rC), where
+ *         points are given in global coordinates and the weights contain the integration elements (so that the
+ *         integral of grid_function is approximated by sum(weights * values)).
+ */
+template <class GridFunctionType, class GridViewType>
+pybind11::tuple sample_at_quadrature_points(const GridFunctionType& grid_function,
+                                            const GridViewType& grid_view,
+                                            const int order,
+                                            const size_t num_threads)
+{
+  using E = typename GridFunctionType::ElementType;
+  using D = typename GridFunctionType::D;
+  static const constexpr size_t d = GridFunctionType::d;
+  static const constexpr size_t r = GridFunctionType::r;
+  static const constexpr size_t rC = GridFunctionType::rC;
+  // determine the quadratures (which are not created concurrently) and the first point of each element
+  std::vector<E> grid_elements;
+  std::vector<const QuadratureRule<D, d>*> quadratures;
+  std::vector<size_t> first_point(1, 0);
+  auto local_function = grid_function.local_function();
+  for (auto&& element : elements(grid_view)) {
+    local_function->bind(element);
+    const int quadrature_order = (order >= 0) ? order : local_function->order();
+    const auto& quadrature = QuadratureRules<D, d>::rule(element.type(), quadrature_order);
+    grid_elements.emplace_back(element);
+    quadratures.emplace_back(&quadrature);
+    first_point.push_back(first_point.back() + quadrature.size());
+  }
+  const size_t num_points = first_point.back();
+  pybind11::array_t<double> points(std::vector<ssize_t>{ssize_t(num_points), ssize_t(d)});
+  pybind11::array_t<double> weights(std::vector<ssize_t>{ssize_t(num_points)});
+  pybind11::array_t<double> values(std::vector<ssize_t>{ssize_t(num_points), ssize_t(r), ssize_t(rC)});
+  double* points_data = points.mutable_data();
+  double* weights_data = weights.mutable_data();
+  double* values_data = values.mutable_data();
+  {
+    pybind11::gil_scoped_release release;
+    parallel_for(grid_elements.size(), num_threads, [&](const size_t begin, const size_t end) {
+      auto thread_local_function = grid_function.local_function();
+      for (size_t ee = begin; ee < end; ++ee) {
+        const auto& element = grid_elements[ee];
+        const auto geometry = element.geometry();
+        thread_local_function->bind(element);
+        size_t pp = first_point[ee];
+        for (const auto& quadrature_point : *quadratures[ee]) {
+          const auto& local_x = quadrature_point.position();
+          double* point_dst = points_data + pp * d;
+          copy_entries(geometry.global(local_x), point_dst);
+          weights_data[pp] = quadrature_point.weight() * geometry.integrationElement(local_x);
+          double* value_dst = values_data + pp * r * rC;
+          copy_entries(thread_local_function->evaluate(local_x), value_dst);
+          ++pp;
+        }
+      }
+    });
+  }
+  return pybind11::make_tuple(points, weights, values);
+} // ... sample_at_quadrature_points(...)
+
+
+} // namespace internal
+} // namespace bindings
+} // namespace Functions
+} // namespace XT
+} // namespace Dune
+
+#endif // PYTHON_DUNE_XT_FUNCTIONS_NUMPY_HH
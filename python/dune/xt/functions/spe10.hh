@@ -24,6 +24,8 @@
 
 #include <python/dune/xt/common/fvector.hh>
 
+#include "checkerboard.hh"
+
 namespace Dune {
 namespace XT {
 namespace Functions {
@@ -92,6 +94,10 @@ bind_Spe10Model1Function(pybind11::module& m, const std::string& grid_id)
         "name"_a = C::static_id());
 
   c.def_property_readonly("static_id", [](const C& /*self*/) { return C::static_id(); });
+  c.def_property_readonly(
+      "values",
+      [](py::object self) { return internal::checkerboard_values_as_array(self.cast<const C&>(), self); },
+      "The values of all subdomains as an array of shape (num_subdomains, r, rC).");
 
   const std::string make_name = "make_spe10_model1_function_" + Common::to_string(r) + "x" + Common::to_string(rC);
   m.def(std::string(make_name).c_str(),
@@ -0,0 +1,62 @@
+# ~~~
+# This file is part of the dune-xt-functions project:
+#   https://github.com/dune-community/dune-xt-functions
+# Copyright 2009-2018 dune-xt-functions developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+
+import gc
+
+import numpy as np
+import pytest
+import dune.xt.functions as xtf
+
+
+def checkerboard_types():
+    return [name for name in dir(xtf) if name.startswith('CheckerboardFunction__') and name.endswith('_to_1x1')]
+
+
+def make_checkerboard_function(type_name, values):
+    dim = 3 if '3d' in type_name else 2 if '2d' in type_name else 1
+    return getattr(xtf, type_name)([0.] * dim, [1.] * dim, [2] * dim, values)
+
+
+def num_subdomains(type_name):
+    return 8 if '3d' in type_name else 4 if '2d' in type_name else 2
+
+
+@pytest.mark.parametrize('type_name', checkerboard_types())
+def test_values_are_not_copied(type_name):
+    values = np.arange(1., num_subdomains(type_name) + 1.).reshape(-1, 1, 1)
+    function = make_checkerboard_function(type_name, values)
+    view = function.values
+    assert np.shares_memory(view, values)
+    values[0, 0, 0] = 42.
+    assert function.values[0, 0, 0] == 42.
+
+
+@pytest.mark.parametrize('type_name', checkerboard_types())
+def test_values_are_kept_alive(type_name):
+    expected_values = np.arange(1., num_subdomains(type_name) + 1.).reshape(-1, 1, 1)
+    values = expected_values.copy()
+    function = make_checkerboard_function(type_name, values)
+    del values
+    gc.collect()
+    assert np.all(function.values == expected_values)
+    view = function.values
+    del function
+    gc.collect()
+    assert np.all(view == expected_values)
+
+
+@pytest.mark.parametrize('type_name', checkerboard_types())
+def test_values_are_read_only(type_name):
+    values = np.arange(1., num_subdomains(type_name) + 1.).reshape(-1, 1, 1)
+    function = make_checkerboard_function(type_name, values)
+    view = function.values
+    assert not view.flags.writeable
+    with pytest.raises(ValueError):
+        view[0, 0, 0] = 17.
+    assert values[0, 0, 0] == 1.
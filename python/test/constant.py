@@ -40,3 +40,19 @@ def test_grid_provider(function_provider):
 
 def test_count():
     pass
+
+
+@pytest.mark.parametrize('dim', [1, 2, 3])
+def test_vectorized_evaluate(dim):
+    import numpy as np
+    function = getattr(xtf, "ConstantFunction__{}d_to_{}x{}".format(dim, 1, 1))([2], 'test_function')
+    points = np.random.rand(5000, dim)
+    values = function.evaluate(points)
+    assert values.shape == (5000, 1, 1)
+    assert np.all(values == 2)
+    assert np.all(function.evaluate(points, num_threads=1) == values)
+    jacobians = function.jacobian(points)
+    assert jacobians.shape == (5000, 1, 1, dim)
+    assert np.all(jacobians == 0)
+    with pytest.raises(Exception):
+        function.evaluate(np.random.rand(10, dim + 1))